@@ -3,124 +3,685 @@
 #include "hardware/adc.h"
 #include "hardware/i2c.h"
 #include "hardware/pwm.h"
+#include "pico/multicore.h"
 #include "pico/stdlib.h"
 #include "./include/button.h"
+#include "./include/calibration.h"
+#include "./include/fft.h"
+#include "./include/filter.h"
 #include "./include/joystick.h"
 #include "./include/led-rgb.h"
+#include "./include/motion.h"
+#include "./include/profile.h"
+#include "./include/scheduler.h"
+#include "./include/spsc-queue.h"
 #include "./include/ssd1306.h"
+#include "./include/trace.h"
+#include "./include/usb-stream.h"
 
 // Defines
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define endereco 0x3C
+#define DISPLAY_PIO pio0                // transporte PIO (com DISPLAY_USE_PIO): bloco usado
+#define DISPLAY_PIO_BAUDRATE 1000000    // fast mode plus
 #define SQUARE_SIZE 8
 #define DISPLAY_WIDTH 128
 #define DISPLAY_HEIGHT 64
+#define BORDER_INNER 4           // primeiro pixel dentro da borda (retângulo em 3,3)
+#define PLOT_LANE_WIDTH 64       // colunas de cada traço no modo gráfico (X à esquerda, Y à direita)
+#define ADC_SAMPLE_RATE 100000   // taxa da aquisição contínua (soma dos eixos X e Y)
+#define FILTER_DECIMATION 5      // média de 2^5 = 32 amostras por eixo (um bloco do anel)
+#define CALIBRATION_HOLD_MS 2000 // tempo segurando A e SW juntos para iniciar a calibração
+#define SAMPLE_PERIOD_US 1000    // período da aquisição e filtragem no núcleo 1 (1 kHz)
+#define LED_PERIOD_US 2000       // período da atualização do PWM dos LEDs no núcleo 1
+#define LED_FADE_MS 30           // duração da transição de brilho dos LEDs
+#define BUTTON_PERIOD_US 10000   // período do tratamento dos eventos de botão no núcleo 0
+#define SQUARE_PERIOD_US 10000   // passo de tempo fixo do modelo de movimento do quadrado (núcleo 0)
+#define DISPLAY_PERIOD_US 20000  // período da composição e envio do quadro ao display
+#define STREAM_PERIOD_US 1000    // período da coleta e do envio dos quadros de amostras pela USB
+#define STATE_QUEUE_SIZE 128     // estados do joystick em trânsito do núcleo 1 para o núcleo 0
+#define COMMAND_QUEUE_SIZE 8     // comandos em trânsito do núcleo 0 para o núcleo 1
+#define TRACE_BUFFER_SIZE (48 * 1024) // gravação das entradas (~8 s de leituras a 1 kHz)
+#define IDLE_TIMEOUT_MS 30000           // sem atividade: modo ocioso (taxas reduzidas e display esmaecido)
+#define DISPLAY_OFF_TIMEOUT_MS 300000   // sem atividade: painel desligado
+#define DISPLAY_CONTRAST 0xFF           // contraste normal do display
+#define IDLE_CONTRAST 0x08              // contraste no modo ocioso
+#define IDLE_ADC_SAMPLE_RATE 6400       // aquisição no modo ocioso: um bloco do anel a cada 10 ms
+#define IDLE_SAMPLE_PERIOD_US 10000     // períodos das tarefas no modo ocioso
+#define IDLE_LED_PERIOD_US 20000
+#define IDLE_STREAM_PERIOD_US 20000
+#define IDLE_DISPLAY_PERIOD_US 100000
+#define ANALYSIS_BITS 8                 // modo de análise: FFT de 256 pares do anel (5,12 ms a 100 kS/s)
+#define ANALYSIS_POINTS (1u << ANALYSIS_BITS)
+#define ANALYSIS_PERIOD_US 100000       // uma análise (e uma linha de cada eixo na USB) a cada 100 ms
+#define ANALYSIS_DB_MIN (-1000)         // base das barras do espectro (décimos de dBFS; o topo é 0 dBFS)
+#define ANALYSIS_BAR_TOP 10             // primeira linha das barras, abaixo do texto com o piso de ruído
+#define ANALYSIS_BINS_PER_COLUMN (ANALYSIS_POINTS / 2 / PLOT_LANE_WIDTH)
+
+// Estado do joystick produzido pelo núcleo 1 a cada ciclo de controle
+typedef struct {
+  uint16_t vrx_value, vry_value;       // leituras filtradas (0-4095)
+  int16_t x_deflection, y_deflection;  // deflexão calibrada (-2047 a 2047)
+  bool calibrating;                    // calibração em andamento no núcleo 1
+  uint32_t time_us;                    // instante da leitura
+} joystick_state_t;
+
+// Comandos do núcleo 0 para o núcleo 1
+typedef enum {
+  COMMAND_LED_ENABLE,
+  COMMAND_LED_DISABLE,
+  COMMAND_CALIBRATE,
+  COMMAND_STREAM_OFF,
+  COMMAND_STREAM_RAW,
+  COMMAND_STREAM_FILTERED,
+  COMMAND_IDLE_ENTER,
+  COMMAND_IDLE_EXIT
+} control_command_t;
+
+// Estados de energia do núcleo 0
+typedef enum {
+  POWER_ACTIVE,       // taxas normais
+  POWER_IDLE,         // taxas reduzidas, display esmaecido e botões por interrupção
+  POWER_DISPLAY_OFF   // como o ocioso, com o painel desligado
+} power_state_t;
+
+// Contexto das tarefas do núcleo 1 (acessado apenas por ele)
+typedef struct {
+  filter_t filter_x, filter_y;     // filtros de sobreamostragem de cada eixo
+  bool led_enabled;
+  uint8_t red_brightness, blue_brightness; // brilho perceptual pedido a cada LED
+  joystick_state_t state;          // último estado calculado
+  bool idle;                       // aquisição e tarefas em taxa reduzida
+  int sample_task, led_task, stream_task; // índices das tarefas no escalonador do núcleo 1
+} control_t;
 
 // Declaração de variáveis
 ssd1306_t ssd;
-uint32_t last_time = 0;                              // variável para contar o último tempo verificado
-absolute_time_t debounce;
-uint slice_led_b, slice_led_r;                       // variáveis para armazenar os slices de PWM correspondentes aos LEDs
-uint16_t vrx_value, vry_value;                       // variáveis dos valores mai recentes de x e y do joystick
-int square_x = 64, square_y = 32;                    // centraliza quadrado nos eixos x e y
-uint16_t led_b_level = 0, led_r_level = 0;           // inicialização dos níveis de PWM para os LEDs
-volatile bool state_led = true, state_border = true; // variáveis de estado do led e da borda
+uint32_t combo_start = 0;                            // instante (ms) em que A e SW foram pressionados juntos
+bool a_held = false, sw_held = false;                // A e SW pressionados, segundo os eventos já tratados
+motion_t square;                                     // posição do quadrado (modo absoluto ou de taxa)
+ssd1306_plot_t plot;                                 // gráfico rolante de X e Y (uma linha por quadro)
+bool plot_mode = false, plot_active = false;         // modo gráfico pedido e em exibição
+bool state_led = true, state_border = true;          // variáveis de estado do led e da borda
+joystick_state_t state_buffer[STATE_QUEUE_SIZE];
+uint8_t command_buffer[COMMAND_QUEUE_SIZE];
+spsc_queue_t state_queue, command_queue;             // únicas vias de troca de dados entre os núcleos
+ssd1306_layer_t border_layers[2];                    // fundos pré-renderizados: borda lisa e de corações
+joystick_state_t ui_state;                           // estado mais recente recebido pelo núcleo 0
+scheduler_t ui_scheduler, control_scheduler;         // um escalonador por núcleo
+control_t control = {.led_enabled = true};
+trace_t trace;                                       // gravação das leituras e dos botões (núcleo 0)
+uint8_t trace_buffer[TRACE_BUFFER_SIZE];
+bool trace_recording = false;
+power_state_t power_state = POWER_ACTIVE;
+uint32_t last_activity_ms = 0;                       // instante da última atividade (joystick, botão ou USB)
+int usb_task, display_task;                          // índices das tarefas no escalonador do núcleo 0
+bool analysis_mode = false;                          // espectro dos eixos no display e na USB
+int16_t analysis_re[FFT_MAX_POINTS], analysis_im[FFT_MAX_POINTS]; // dados da FFT (e do benchmark)
+uint16_t analysis_block[2 * ANALYSIS_POINTS];        // pares [Y, X] copiados do anel
+int16_t spectrum[2][ANALYSIS_POINTS / 2];            // décimos de dBFS por raia: [0] X, [1] Y
+int16_t noise_floor[2];
+uint32_t bus_start_us = 0;                           // início do envio em andamento (etapa "bus" do profile)
+bool bus_pending = false;
 
 // Cabeçalho das funções
-void button_irq_handler(uint gpio, uint32_t events);
-void update_square_position(int *square_x, int *square_y, uint16_t vrx_value, uint16_t vry_value);
+void handle_button_event(const button_event_t *event);
+void toggle_border(void);
+void toggle_leds(void);
+void core1_entry(void);
+void task_buttons(void *context);
+void task_square(void *context);
+void task_display(void *context);
+void task_sample(void *context);
+void task_leds(void *context);
+void task_usb(void *context);
+void task_stream(void *context);
+void task_analysis(void *context);
+void analysis_draw(void);
+void send_command(control_command_t command);
+void trace_dump(void);
+void power_activity(void);
+void power_update(void);
+void control_set_idle(control_t *ctrl, bool idle);
+void profile_bus_start(uint32_t start_us);
+void profile_bus_poll(void);
 
-// Função principal
+// Função principal (núcleo 0: botões, desenho e envio ao display)
 int main() {
     stdio_init_all();
 
+    spsc_queue_init(&state_queue, state_buffer, sizeof(joystick_state_t), STATE_QUEUE_SIZE);
+    spsc_queue_init(&command_queue, command_buffer, sizeof(uint8_t), COMMAND_QUEUE_SIZE);
+    stream_init();
+    flash_safe_execute_core_init();  // permite que o núcleo 1 pause este núcleo ao gravar a calibração
+    multicore_launch_core1(core1_entry);
+
     // Inicialização dos pinos
     button_init(SW);
     button_init(BUTTON_A_PIN);
-    setup_joystick();
-    pwm_led_setup(BLUE_LED_PIN, &slice_led_b, led_b_level, state_led); // configura o PWM para o LED azul
-    pwm_led_setup(RED_LED_PIN, &slice_led_r, led_r_level, state_led);  // configura o PWM para o LED vermelho
     led_init(GREEN_LED_PIN);
 
     // Inicialização do I2C e do display OLED
+#ifdef DISPLAY_USE_PIO
+    // Mestre I2C no PIO, nos mesmos pinos, em 1 MHz
+    uint display_sm = ssd1306_pio_setup(DISPLAY_PIO, I2C_SDA, I2C_SCL, DISPLAY_PIO_BAUDRATE);
+    ssd1306_init_pio(&ssd, DISPLAY_WIDTH, DISPLAY_HEIGHT, false, endereco, DISPLAY_PIO, display_sm);
+#else
     i2c_init(I2C_PORT, 400 * 1000);                               // usando-o em 400KHz
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);                    // set the GPIO pin function to I2C
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);                    // set the GPIO pin function to I2C
     gpio_pull_up(I2C_SDA);                                        // pull up the data line
     gpio_pull_up(I2C_SCL);                                        // pull up the clock line
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, endereco, I2C_PORT); // inicializa o display
+    ssd1306_init(&ssd, DISPLAY_WIDTH, DISPLAY_HEIGHT, false, endereco, I2C_PORT); // inicializa o display
+#endif
     ssd1306_config(&ssd);                                         // configura o display
     ssd1306_send_data(&ssd);                                      // envia os dados para o display
+    ssd1306_dma_init(&ssd);                                       // habilita o envio assíncrono por DMA
 
-    // Interrupções dos botões A e SW
-    gpio_set_irq_enabled_with_callback(SW, GPIO_IRQ_EDGE_FALL, true, &button_irq_handler);
-    gpio_set_irq_enabled_with_callback(BUTTON_A_PIN, GPIO_IRQ_EDGE_FALL, true, &button_irq_handler);
-
-    debounce = delayed_by_ms(get_absolute_time(), 200); // inicializa o debounce
+    // Amostragem periódica dos botões A e SW, com debounce e fila de eventos
+    button_events_start();
 
-    // Limpa o display, desenha a borda e envia os dados para serem exibidos
+    // Pré-renderiza as duas bordas uma única vez; cada quadro parte de uma cópia delas
+    ssd1306_layer_init(&ssd, &border_layers[0]);
+    ssd1306_layer_init(&ssd, &border_layers[1]);
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect_hearts(&ssd, 3, 3, 122, 58, true);
+    ssd1306_layer_save(&ssd, &border_layers[1]);
     ssd1306_fill(&ssd, false);
     ssd1306_rect(&ssd, 3, 3, 122, 58, true);
+    ssd1306_layer_save(&ssd, &border_layers[0]);
     ssd1306_send_data(&ssd);
 
-    while (true) {
-        joystick_read_axis(&vrx_value, &vry_value); // lê os valores dos eixos do joystick
+    fft_init(); // tabela de senos do modo de análise
 
-        // Define intervalo para ativação e só aciona os LEDs se o state_led for true
-        // (intervalo baseado nos valores obtidos no monitor serial para cada coordenada)
-        if ((vrx_value >= 2400 || vrx_value <= 2120) && state_led) {
-            led_r_level = abs(vrx_value - 2047) * 2;
-        } else { // caso contrário, mantém o level em 0
-            led_r_level = 0;
-        }
+    // O quadrado se move dentro da borda, começando centralizado no modo absoluto
+    motion_init(&square, BORDER_INNER, BORDER_INNER,
+                DISPLAY_WIDTH - BORDER_INNER - SQUARE_SIZE, DISPLAY_HEIGHT - BORDER_INNER - SQUARE_SIZE);
 
-        // Ocorre o mesmo aqui
-        if ((vry_value >= 2100 || vry_value <= 1850) && state_led) {
-            led_b_level = abs(vry_value - 2047) * 2;
-        }
-        else {
-            led_b_level = 0;
+    // Cada atividade roda no seu período; entre os prazos o núcleo dorme
+    scheduler_init(&ui_scheduler);
+    usb_task = scheduler_add(&ui_scheduler, task_usb, NULL, STREAM_PERIOD_US, 4);
+    scheduler_add(&ui_scheduler, task_buttons, NULL, BUTTON_PERIOD_US, 3);
+    scheduler_add(&ui_scheduler, task_square, NULL, SQUARE_PERIOD_US, 2);
+    display_task = scheduler_add(&ui_scheduler, task_display, NULL, DISPLAY_PERIOD_US, 1);
+    scheduler_add(&ui_scheduler, task_analysis, NULL, ANALYSIS_PERIOD_US, 0);
+    last_activity_ms = to_ms_since_boot(get_absolute_time());
+    scheduler_run(&ui_scheduler);
+}
+
+// Tarefa do núcleo 0 que trata os eventos de botão e o atalho de calibração
+void task_buttons(void *context) {
+    button_event_t event;
+
+    // Com o painel desligado, o toque que acorda o sistema não tem outro efeito
+    if (power_state == POWER_DISPLAY_OFF && button_get_event(&event)) {
+        power_activity();
+        while (button_get_event(&event))
+            ;
+        return;
+    }
+
+    // Trata todos os eventos de botão acumulados desde a última execução
+    while (button_get_event(&event)) {
+        power_activity();
+        if (trace_recording && (event.type == BUTTON_EVENT_PRESS || event.type == BUTTON_EVENT_RELEASE))
+            trace_recording = trace_record_button(&trace, event.time_ms * 1000, event.gpio,
+                                                  event.type == BUTTON_EVENT_PRESS);
+        handle_button_event(&event);
+    }
+
+    // Segurar A e SW juntos inicia a calibração (centro, extremos e zona morta)
+    if (button_is_pressed(BUTTON_A_PIN) && button_is_pressed(SW)) {
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+        if (combo_start == 0) {
+            combo_start = now;
+        } else if (now - combo_start >= CALIBRATION_HOLD_MS) {
+            send_command(COMMAND_CALIBRATE);
+            combo_start = now;
         }
+    } else {
+        combo_start = 0;
+    }
+}
+
+// Tarefa do núcleo 0 que atende a USB: comandos de um caractere vindos do host
+// ('r' amostras brutas, 'f' filtradas, 's' para, 't' inicia ou para a gravação das
+// entradas, 'd' envia a gravação, 'a' alterna o modo de análise, 'b' mede os ciclos
+// da FFT) e envio dos quadros prontos
+void task_usb(void *context) {
+    int c;
 
-        // Ajusta os níveis PWM dos LEDs de acordo com os valores do joystick
-        pwm_set_gpio_level(RED_LED_PIN, led_r_level);
-        pwm_set_gpio_level(BLUE_LED_PIN, led_b_level);
+    profile_bus_poll();
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        power_activity();
+        if (c == 'r')
+            send_command(COMMAND_STREAM_RAW);
+        else if (c == 'f')
+            send_command(COMMAND_STREAM_FILTERED);
+        else if (c == 's')
+            send_command(COMMAND_STREAM_OFF);
+        else if (c == 't' && !trace_recording) {
+            trace_init(&trace, trace_buffer, sizeof(trace_buffer), time_us_32());
+            trace_recording = true;
+        } else if (c == 't')
+            trace_recording = false;
+        else if (c == 'd')
+            trace_dump();
+        else if (c == 'a')
+            analysis_mode = !analysis_mode;
+        else if (c == 'b')
+            fft_benchmark(analysis_re, analysis_im);
+    }
 
-        ssd1306_fill(&ssd, false); // limpa o display
+    stream_flush();
+}
+
+// Tarefa do núcleo 0 que consome os estados do núcleo 1 e move o quadrado
+void task_square(void *context) {
+    // Consome todos os estados produzidos pelo núcleo 1 e fica com o mais recente;
+    // durante a gravação, cada leitura vai para o trace (que para quando enche)
+    while (spsc_queue_pop(&state_queue, &ui_state)) {
+        if (trace_recording)
+            trace_recording = trace_record_sample(&trace, ui_state.time_us, ui_state.vrx_value, ui_state.vry_value);
+        if (ui_state.x_deflection || ui_state.y_deflection || ui_state.calibrating)
+            power_activity();
+    }
+
+    // Avança o modelo de movimento um passo (o período da tarefa é o passo de tempo)
+    motion_step(&square, ui_state.x_deflection, ui_state.y_deflection);
+
+    power_update();
+}
 
-        // Atualiza a posição do quadrado com base nos valores do joystick
-        update_square_position(&square_x, &square_y, vrx_value, vry_value);
+// Função que registra uma atividade e, se o sistema estiver ocioso, volta ao modo
+// ativo: painel ligado, contraste normal e taxas normais nos dois núcleos
+void power_activity(void) {
+    last_activity_ms = to_ms_since_boot(get_absolute_time());
+    if (power_state == POWER_ACTIVE)
+        return;
 
-        // Desenha a borda lisa ou de corações de acordo com o state_border 
-        // (modificado na função de callback de interrupção do botão)
-        if (state_border) {
-            ssd1306_rect(&ssd, 3, 3, 122, 58, true);
+    if (power_state == POWER_DISPLAY_OFF)
+        ssd1306_set_power(&ssd, true);
+    ssd1306_set_contrast(&ssd, DISPLAY_CONTRAST);
+    scheduler_set_period(&ui_scheduler, usb_task, STREAM_PERIOD_US);
+    scheduler_set_period(&ui_scheduler, display_task, DISPLAY_PERIOD_US);
+    scheduler_trigger(&ui_scheduler, display_task); // o quadro atualizado sai já na volta
+    send_command(COMMAND_IDLE_EXIT);
+    power_state = POWER_ACTIVE;
+}
+
+// Função que passa aos modos ocioso e de painel desligado após os tempos sem atividade.
+// Envio pela USB, gravação, modo gráfico e calibração contam como atividade contínua
+void power_update(void) {
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+
+    if (stream_get_mode() != STREAM_OFF || trace_recording || plot_mode || analysis_mode)
+        last_activity_ms = now;
+
+    if (power_state == POWER_ACTIVE && now - last_activity_ms >= IDLE_TIMEOUT_MS) {
+        // Os botões só passam à interrupção se estiverem soltos; senão, tenta no próximo passo
+        if (!button_events_idle())
+            return;
+        ssd1306_set_contrast(&ssd, IDLE_CONTRAST);
+        scheduler_set_period(&ui_scheduler, usb_task, IDLE_STREAM_PERIOD_US);
+        scheduler_set_period(&ui_scheduler, display_task, IDLE_DISPLAY_PERIOD_US);
+        send_command(COMMAND_IDLE_ENTER);
+        power_state = POWER_IDLE;
+    } else if (power_state == POWER_IDLE && now - last_activity_ms >= DISPLAY_OFF_TIMEOUT_MS) {
+        ssd1306_wait_flush(&ssd);
+        ssd1306_set_power(&ssd, false);
+        power_state = POWER_DISPLAY_OFF;
+    }
+}
+
+// Tarefa do núcleo 0 que compõe o quadro e inicia o envio ao display
+void task_display(void *context) {
+    // Com o painel desligado não há o que desenhar; o buffer é atualizado ao acordar
+    if (power_state == POWER_DISPLAY_OFF)
+        return;
+
+    PROFILE_TICK(PROFILE_FRAME);
+    PROFILE_REPORT();
+
+    PROFILE_BEGIN(PROFILE_DRAW);
+
+    // Modo gráfico: uma linha nova por quadro com X e Y; só essa linha e a rolagem
+    // vão para o barramento
+    if (plot_mode && !analysis_mode && !ui_state.calibrating) {
+        if (!plot_active)
+            ssd1306_plot_init(&ssd, &plot, 2);
+        plot_active = true;
+
+        uint8_t columns[2] = {
+            (ui_state.x_deflection + 2048) * PLOT_LANE_WIDTH / 4096,
+            PLOT_LANE_WIDTH + (ui_state.y_deflection + 2048) * PLOT_LANE_WIDTH / 4096
+        };
+        ssd1306_plot_push(&ssd, &plot, columns);
+    } else {
+        // Sai do modo gráfico desfazendo a rolagem
+        if (plot_active)
+            ssd1306_set_start_line(&ssd, 0);
+        plot_active = false;
+
+        if (analysis_mode && !ui_state.calibrating) {
+            // Modo de análise: o espectro ocupa a tela toda, sem a borda
+            analysis_draw();
         } else {
-            ssd1306_rect_hearts(&ssd, 3, 3, 122, 58, true);
+            // Começa o quadro com a borda lisa ou de corações de acordo com o state_border
+            // (alternado pelo botão SW)
+            ssd1306_layer_load(&ssd, &border_layers[state_border ? 0 : 1]);
+
+            // Durante a calibração exibe as leituras ao vivo; fora dela, o quadrado de 8x8 pixels
+            if (ui_state.calibrating) {
+                char text[16];
+                ssd1306_draw_string(&ssd, "CALIBRANDO", 34, 16);
+                snprintf(text, sizeof(text), "X:%4u Y:%4u", ui_state.vrx_value, ui_state.vry_value);
+                ssd1306_draw_string(&ssd, text, 28, 36);
+            } else {
+                ssd1306_rect(&ssd, motion_pixel_y(&square), motion_pixel_x(&square), SQUARE_SIZE, SQUARE_SIZE, true);
+            }
         }
+    }
+
+    PROFILE_END(PROFILE_DRAW);
 
-        // Desenha o quadrado de 8x8 pixels
-        ssd1306_rect(&ssd, square_x - 4, square_y - 8, SQUARE_SIZE, SQUARE_SIZE, true);
+    // Inicia o envio dos dados para o display sem bloquear; se o quadro anterior
+    // ainda estiver em envio, as alterações seguem no próximo ciclo
+    PROFILE_BEGIN(PROFILE_FLUSH);
+    uint32_t flush_start_us = time_us_32();
+    if (ssd1306_send_data_async(&ssd) && ssd.last_flush_bytes > 0)
+        profile_bus_start(flush_start_us);
+    PROFILE_END(PROFILE_FLUSH);
+}
 
-        // Envia os dados para o display
-        ssd1306_send_data(&ssd);
+// Função que marca o início de um envio ao display para a etapa "bus" do profile
+void profile_bus_start(uint32_t start_us) {
+#if PROFILE_ENABLED
+    bus_start_us = start_us;
+    bus_pending = true;
+    profile_bus_poll(); // o envio bloqueante (sem DMA) já terminou
+#endif
+}
 
-        sleep_ms(40);        // pequeno delay antes da próxima leitura
+// Função que registra a etapa "bus" (início do envio até o último byte no barramento)
+// quando o envio termina, sem esperar por ele; chamada também pela tarefa da USB, o
+// fim é visto com a resolução do período dela (1 ms)
+void profile_bus_poll(void) {
+#if PROFILE_ENABLED
+    if (bus_pending && ssd1306_flush_done(&ssd)) {
+        profile_record(PROFILE_BUS, time_us_32() - bus_start_us);
+        bus_pending = false;
     }
+#endif
 }
 
-// Função de callback que trata a interrupção do botão
-void button_irq_handler(uint gpio, uint32_t events) {
-    if (time_reached(debounce)) { // verifica se o tempo de debounce já passou
-        if (gpio == SW) {
-            state_border = !state_border;
-            gpio_put(GREEN_LED_PIN, !gpio_get(GREEN_LED_PIN)); // alterna o LED verde
+// Tarefa do núcleo 0 do modo de análise: copia os últimos ANALYSIS_POINTS pares do
+// anel da aquisição contínua, calcula o espectro de cada eixo e o envia pela USB, uma
+// linha por eixo: "fft <eixo> <taxa por eixo, Hz> <pontos> <piso> <pico, Hz> <pico>"
+// seguido das raias 0 a ANALYSIS_POINTS / 2 - 1, níveis em décimos de dBFS
+void task_analysis(void *context) {
+    if (!analysis_mode || !joystick_streaming())
+        return;
+
+    // O DMA só volta a este trecho meio anel depois (5 ms a 100 kS/s); a cópia leva
+    // alguns microssegundos
+    const uint16_t *ring = joystick_stream_ring();
+    uint32_t end = joystick_stream_position() & ~1u; // fim do último par completo
+    for (size_t i = 0; i < 2 * ANALYSIS_POINTS; ++i)
+        analysis_block[i] = ring[(end - 2 * ANALYSIS_POINTS + i) & (JOYSTICK_RING_SAMPLES - 1)];
+    uint32_t rate = joystick_stream_rate() / 2;
+
+    for (uint8_t axis = 0; axis < 2; ++axis) {
+        // Pares intercalados [Y, X]: X começa na posição 1
+        fft_window(analysis_re, analysis_im, analysis_block + (axis == 0), 2, ANALYSIS_BITS);
+        uint8_t exponent = fft_run(analysis_re, analysis_im, ANALYSIS_BITS);
+        fft_spectrum_db(analysis_re, analysis_im, ANALYSIS_BITS, exponent, spectrum[axis]);
+
+        // As raias 0 e 1 têm o vazamento da média pela janela e ficam fora do piso e do pico
+        noise_floor[axis] = fft_noise_floor(spectrum[axis] + 2, ANALYSIS_POINTS / 2 - 2);
+        size_t peak = 2;
+        for (size_t k = 3; k < ANALYSIS_POINTS / 2; ++k) {
+            if (spectrum[axis][k] > spectrum[axis][peak])
+                peak = k;
         }
-        else if (gpio == BUTTON_A_PIN) {
-            state_led = !state_led;
+
+        printf("fft %c %lu %u %d %lu %d", axis == 0 ? 'X' : 'Y', (unsigned long) rate, ANALYSIS_POINTS,
+               noise_floor[axis], (unsigned long) ((peak * rate) >> ANALYSIS_BITS), spectrum[axis][peak]);
+        for (size_t k = 0; k < ANALYSIS_POINTS / 2; ++k)
+            printf(" %d", spectrum[axis][k]);
+        printf("\n");
+    }
+}
+
+// Função que converte um nível (décimos de dBFS) na altura de uma barra do espectro
+static uint8_t analysis_bar_height(int16_t db) {
+    const int32_t height = DISPLAY_HEIGHT - ANALYSIS_BAR_TOP;
+    int32_t h = (db - ANALYSIS_DB_MIN) * height / -ANALYSIS_DB_MIN;
+    return h < 0 ? 0 : h > height ? height : h;
+}
+
+// Função que desenha o espectro: X à esquerda e Y à direita, como no modo gráfico,
+// com o maior nível de ANALYSIS_BINS_PER_COLUMN raias por coluna, o piso de ruído
+// pontilhado e, no topo, o piso em dBFS de cada eixo
+void analysis_draw(void) {
+    char text[24];
+
+    ssd1306_fill(&ssd, false);
+    snprintf(text, sizeof(text), "X%4d   Y%4d DB", noise_floor[0] / 10, noise_floor[1] / 10);
+    ssd1306_draw_string(&ssd, text, 0, 0);
+
+    for (uint8_t axis = 0; axis < 2; ++axis) {
+        uint8_t left = axis * PLOT_LANE_WIDTH;
+
+        // A coluna 0 (média) fica vazia e separa os dois eixos
+        for (uint8_t column = 1; column < PLOT_LANE_WIDTH; ++column) {
+            const int16_t *bins = &spectrum[axis][column * ANALYSIS_BINS_PER_COLUMN];
+            int16_t level = bins[0];
+            for (uint8_t i = 1; i < ANALYSIS_BINS_PER_COLUMN; ++i)
+                level = bins[i] > level ? bins[i] : level;
+
+            uint8_t h = analysis_bar_height(level);
+            if (h)
+                ssd1306_fill_rect(&ssd, DISPLAY_HEIGHT - h, left + column, 1, h, true);
         }
-        debounce = delayed_by_ms(get_absolute_time(), 200); // atualiza o debounce
+
+        uint8_t floor_y = DISPLAY_HEIGHT - 1 - analysis_bar_height(noise_floor[axis]);
+        for (uint8_t column = 1; column < PLOT_LANE_WIDTH; column += 4)
+            ssd1306_pixel(&ssd, left + column, floor_y, true);
+    }
+}
+
+// Função do núcleo 1: aquisição, filtragem, calibração e PWM dos LEDs em taxa fixa
+void core1_entry(void) {
+    setup_joystick();
+    joystick_stream_start(ADC_SAMPLE_RATE); // inicia a aquisição contínua dos eixos por DMA
+    filter_init(&control.filter_x, FILTER_BOXCAR, FILTER_DECIMATION, 0);
+    filter_init(&control.filter_y, FILTER_BOXCAR, FILTER_DECIMATION, 0);
+    calibration_init(); // carrega a calibração da flash e monta as tabelas de mapeamento
+    led_pwm_init(LED_PWM_BITS, LED_PWM_FREQUENCY);
+    led_pwm_setup(BLUE_LED_PIN); // configura o PWM para o LED azul
+    led_pwm_setup(RED_LED_PIN);  // configura o PWM para o LED vermelho
+
+    scheduler_init(&control_scheduler);
+    control.stream_task = scheduler_add(&control_scheduler, task_stream, NULL, STREAM_PERIOD_US, 3);
+    control.sample_task = scheduler_add(&control_scheduler, task_sample, &control, SAMPLE_PERIOD_US, 2);
+    control.led_task = scheduler_add(&control_scheduler, task_leds, &control, LED_PERIOD_US, 1);
+    scheduler_run(&control_scheduler);
+}
+
+// Função do núcleo 1 que troca entre as taxas normais e as do modo ocioso: no ocioso
+// o ADC converte 6,4 kS/s em vez de 100 kS/s e cada tarefa acorda bem menos vezes,
+// deixando o núcleo em WFE a maior parte do tempo
+void control_set_idle(control_t *ctrl, bool idle) {
+    if (idle == ctrl->idle)
+        return;
+    ctrl->idle = idle;
+
+    joystick_stream_start(idle ? IDLE_ADC_SAMPLE_RATE : ADC_SAMPLE_RATE);
+    scheduler_set_period(&control_scheduler, ctrl->sample_task, idle ? IDLE_SAMPLE_PERIOD_US : SAMPLE_PERIOD_US);
+    scheduler_set_period(&control_scheduler, ctrl->led_task, idle ? IDLE_LED_PERIOD_US : LED_PERIOD_US);
+    scheduler_set_period(&control_scheduler, ctrl->stream_task, idle ? IDLE_STREAM_PERIOD_US : STREAM_PERIOD_US);
+}
+
+// Tarefa do núcleo 1: comandos, filtragem, calibração e envio do estado ao núcleo 0
+void task_sample(void *context) {
+    control_t *ctrl = context;
+    joystick_state_t *state = &ctrl->state;
+    uint8_t command;
+
+    PROFILE_TICK(PROFILE_CONTROL);
+
+    while (spsc_queue_pop(&command_queue, &command)) {
+        if (command == COMMAND_LED_ENABLE)
+            ctrl->led_enabled = true;
+        else if (command == COMMAND_LED_DISABLE)
+            ctrl->led_enabled = false;
+        else if (command == COMMAND_CALIBRATE && !calibration_active())
+            calibration_start();
+        else if (command == COMMAND_STREAM_OFF)
+            stream_set_mode(STREAM_OFF);
+        else if (command == COMMAND_STREAM_RAW)
+            stream_set_mode(STREAM_RAW);
+        else if (command == COMMAND_STREAM_FILTERED)
+            stream_set_mode(STREAM_FILTERED);
+        else if (command == COMMAND_IDLE_ENTER)
+            control_set_idle(ctrl, true);
+        else if (command == COMMAND_IDLE_EXIT)
+            control_set_idle(ctrl, false);
+    }
+
+    // Filtra o bloco mais recente do anel (amostras intercaladas [Y, X]) e
+    // descarta os bits fracionários para manter a escala de 12 bits
+    PROFILE_BEGIN(PROFILE_ACQUIRE);
+    const uint16_t *block = joystick_stream_latest();
+    filter_process(&ctrl->filter_y, block, JOYSTICK_BLOCK_SAMPLES / 2, 2);
+    filter_process(&ctrl->filter_x, block + 1, JOYSTICK_BLOCK_SAMPLES / 2, 2);
+    state->vry_value = ctrl->filter_y.output >> FILTER_FRAC_BITS;
+    state->vrx_value = ctrl->filter_x.output >> FILTER_FRAC_BITS;
+    state->time_us = time_us_32();
+    PROFILE_END(PROFILE_ACQUIRE);
+
+    stream_push_filtered(state->vrx_value, state->vry_value);
+
+    PROFILE_BEGIN(PROFILE_MAP);
+    calibration_update(state->vrx_value, state->vry_value);
+    state->calibrating = calibration_active();
+
+    // Converte as leituras em deflexão calibrada (0 dentro da zona morta)
+    state->x_deflection = calibration_map_x(state->vrx_value);
+    state->y_deflection = calibration_map_y(state->vry_value);
+    PROFILE_END(PROFILE_MAP);
+
+    // No modo ocioso, mover o joystick já devolve as taxas normais a este núcleo,
+    // sem esperar o comando do núcleo 0
+    if (ctrl->idle && (state->x_deflection || state->y_deflection))
+        control_set_idle(ctrl, false);
+
+    // Se o núcleo 0 atrasar e a fila encher, o estado é descartado; o núcleo 0
+    // sempre usa o mais recente que conseguir ler
+    spsc_queue_push(&state_queue, state);
+}
+
+// Tarefa do núcleo 1 que empacota as amostras brutas do anel no modo de envio bruto
+void task_stream(void *context) {
+    stream_poll_raw();
+}
+
+// Tarefa do núcleo 1 que atualiza o PWM dos LEDs com o último estado
+void task_leds(void *context) {
+    control_t *ctrl = context;
+
+    uint8_t red = 0, blue = 0;
+
+    // Os LEDs só acendem fora da zona morta e com o botão A habilitando
+    // (durante a calibração ficam apagados); a deflexão de 11 bits vira brilho de 8 bits
+    PROFILE_BEGIN(PROFILE_PWM);
+    if (ctrl->led_enabled && !ctrl->state.calibrating) {
+        red = abs(ctrl->state.x_deflection) >> 3;
+        blue = abs(ctrl->state.y_deflection) >> 3;
+    }
+
+    // Só uma mudança de brilho inicia uma nova transição; o DMA faz o resto
+    if (red != ctrl->red_brightness) {
+        ctrl->red_brightness = red;
+        led_fade_to(RED_LED_PIN, red, LED_FADE_MS);
+    }
+    if (blue != ctrl->blue_brightness) {
+        ctrl->blue_brightness = blue;
+        led_fade_to(BLUE_LED_PIN, blue, LED_FADE_MS);
+    }
+    PROFILE_END(PROFILE_PWM);
+}
+
+// Função que envia a gravação pela USB: cabeçalho (com o tamanho) e registros
+void trace_dump(void) {
+    uint8_t header[TRACE_HEADER_SIZE];
+
+    trace_recording = false;
+    trace_header(&trace, header);
+    stdio_put_string((const char *) header, sizeof(header), false, false);
+    stdio_put_string((const char *) trace.data, trace.len, false, false);
+}
+
+// Função que envia um comando ao núcleo 1 (produtor único: o laço principal do núcleo 0)
+void send_command(control_command_t command) {
+    uint8_t item = command;
+    spsc_queue_push(&command_queue, &item);
+}
+
+// Função que trata um evento de botão: SW alterna a borda e o LED verde, A liga e desliga os LEDs PWM,
+// o clique duplo em A alterna o quadrado entre os modos absoluto e de taxa e o clique duplo em SW
+// alterna o modo gráfico (os dois cliques devolvem os LEDs e a borda ao estado anterior); o toque
+// longo só em SW (sem A, que com SW inicia a calibração) alterna o modo de análise
+void handle_button_event(const button_event_t *event) {
+    if (event->type == BUTTON_EVENT_LONG_PRESS && event->gpio == SW && !button_is_pressed(BUTTON_A_PIN)) {
+        analysis_mode = !analysis_mode;
+        return;
+    }
+    if (event->type == BUTTON_EVENT_DOUBLE_CLICK && event->gpio == BUTTON_A_PIN) {
+        motion_set_mode(&square, square.mode == MOTION_ABSOLUTE ? MOTION_RATE : MOTION_ABSOLUTE);
+        return;
     }
+    if (event->type == BUTTON_EVENT_DOUBLE_CLICK && event->gpio == SW) {
+        plot_mode = !plot_mode;
+        return;
+    }
+    if (event->type == BUTTON_EVENT_RELEASE) {
+        *(event->gpio == SW ? &sw_held : &a_held) = false;
+        return;
+    }
+    if (event->type != BUTTON_EVENT_PRESS)
+        return;
+
+    // Toque com o outro botão já pressionado: início do atalho de calibração (A e SW
+    // juntos). Este toque é ignorado e o do outro botão é desfeito, para que borda, LED
+    // verde e LEDs PWM fiquem como estavam antes do atalho
+    bool other_held = event->gpio == SW ? a_held : sw_held;
+    *(event->gpio == SW ? &sw_held : &a_held) = true;
+    if (other_held) {
+        if (event->gpio == SW)
+            toggle_leds();
+        else
+            toggle_border();
+        return;
+    }
+
+    if (event->gpio == SW)
+        toggle_border();
+    else if (event->gpio == BUTTON_A_PIN)
+        toggle_leds();
+}
+
+// Função que alterna a borda e o LED verde (toque em SW)
+void toggle_border(void) {
+    state_border = !state_border;
+    gpio_put(GREEN_LED_PIN, !gpio_get(GREEN_LED_PIN)); // alterna o LED verde
+}
+
+// Função que liga ou desliga os LEDs PWM (toque em A)
+void toggle_leds(void) {
+    state_led = !state_led;
+    send_command(state_led ? COMMAND_LED_ENABLE : COMMAND_LED_DISABLE);
 }
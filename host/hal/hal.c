@@ -0,0 +1,1102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "pico/stdio.h"
+#include "pico/stdio_usb.h"
+#include "pico/flash.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "hardware/structs/systick.h"
+
+// Declaração de variáveis
+
+static uint64_t now_us;
+static uint64_t end_us;           // fim da simulação (0 = sem fim)
+static repeating_timer_t *timers; // lista de temporizadores ativos
+
+// Núcleos: contextos e prazo até o qual cada um está dormindo
+#define HAL_CORE1_STACK (1024 * 1024)
+static ucontext_t core_contexts[2];
+static absolute_time_t core_wake[2];
+static uint current_core;
+static bool core1_launched;
+static void (*core1_entry)(void);
+
+// GPIO
+static bool gpio_values[NUM_BANK0_GPIOS];
+static uint32_t gpio_irq_events[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t gpio_callback;
+
+// ADC
+static adc_hw_t adc_regs;
+adc_hw_t *adc_hw = &adc_regs;
+static uint16_t (*adc_trace)[2];
+static size_t adc_trace_len;
+static size_t adc_trace_pos[2];
+static uint16_t adc_values[5] = {2048, 2048, 2048, 2048, 2048};
+static uint adc_input, adc_round_robin;
+static bool adc_running, adc_fifo_dreq;
+static float adc_clkdiv;
+static uint64_t adc_conversions, adc_time_rest;
+
+// DMA
+typedef struct {
+  bool claimed, busy;
+  dma_channel_config config;
+  uint64_t timer_rest;   // resto de ciclos do ritmo do temporizador de DMA
+  uint64_t bus_rest_ns;  // tempo de barramento ainda não gasto (canais no ritmo do I2C ou do PIO)
+  uint32_t reload;       // último TRANS_COUNT escrito, recarregado a cada disparo
+} dma_channel_state_t;
+
+typedef struct {
+  bool claimed;
+  uint16_t numerator, denominator;
+} dma_timer_state_t;
+
+static dma_hw_t dma_regs;
+dma_hw_t *dma_hw = &dma_regs;
+static dma_channel_state_t dma_channels[NUM_DMA_CHANNELS];
+static dma_timer_state_t dma_timers[NUM_DMA_TIMERS];
+
+// I2C
+i2c_inst_t i2c0_inst = {.index = 0}, i2c1_inst = {.index = 1};
+static hal_i2c_callback_t i2c_callback;
+static void *i2c_context;
+static uint64_t i2c_bytes, i2c_transactions;
+static uint8_t i2c_pending[4096];
+static size_t i2c_pending_len;
+static bool bus_paced;      // transação entregue pelo DMA no ritmo do barramento: o relógio já avançou
+
+// PIO: cada máquina de estado decodifica as palavras do programa I2C (ssd1306-i2c.pio)
+typedef struct {
+  bool claimed;
+  float clkdiv;
+  uint escape, escape_len;   // instruções restantes e tamanho da sequência de START/STOP em curso
+  uint8_t bytes[4096];       // transação em montagem (endereço + dados)
+  size_t len;
+} hal_pio_sm_t;
+
+pio_hw_t pio0_hw = {.index = 0}, pio1_hw = {.index = 1};
+static hal_pio_sm_t pio_sms[NUM_PIOS][NUM_PIO_STATE_MACHINES];
+static uint pio_program_end[NUM_PIOS];
+
+// PWM
+static pwm_hw_t pwm_regs;
+pwm_hw_t *pwm_hw = &pwm_regs;
+static uint64_t pwm_writes[NUM_BANK0_GPIOS];
+
+// USB (stdio)
+static FILE *usb_output;
+static const char *usb_input;
+
+// Flash
+uint8_t hal_flash[PICO_FLASH_SIZE_BYTES];
+
+// Funções
+
+// Tempo
+
+static void hal_adc_run_for(uint64_t us);
+static void hal_dma_timers_run_for(uint64_t us);
+static void hal_dma_bus_run_for(uint64_t us);
+
+// Função que avança o relógio até target, disparando os temporizadores vencidos em ordem
+void hal_time_advance_us(uint64_t us) {
+    uint64_t target = now_us + us;
+
+    if (end_us && target > end_us)
+        target = end_us;
+
+    while (true) {
+        repeating_timer_t *due = NULL;
+        for (repeating_timer_t *timer = timers; timer; timer = timer->link) {
+            if (timer->next <= target && (!due || timer->next < due->next))
+                due = timer;
+        }
+        if (!due)
+            break;
+
+        if (due->next > now_us) {
+            hal_adc_run_for(due->next - now_us);
+            hal_dma_timers_run_for(due->next - now_us);
+            hal_dma_bus_run_for(due->next - now_us);
+            now_us = due->next;
+        }
+        // Período negativo: intervalo fixo entre inícios; positivo: a partir do fim do callback
+        due->next = now_us + (due->delay_us < 0 ? -due->delay_us : due->delay_us);
+        if (!due->callback(due))
+            cancel_repeating_timer(due);
+    }
+
+    hal_adc_run_for(target - now_us);
+    hal_dma_timers_run_for(target - now_us);
+    hal_dma_bus_run_for(target - now_us);
+    now_us = target;
+
+    if (end_us && now_us >= end_us)
+        exit(0);
+}
+
+void hal_time_set_end(uint64_t us) {
+    end_us = us;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->next = now_us + (delay_us < 0 ? -delay_us : delay_us);
+    out->callback = callback;
+    out->user_data = user_data;
+    out->link = timers;
+    timers = out;
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t) delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    for (repeating_timer_t **link = &timers; *link; link = &(*link)->link) {
+        if (*link == timer) {
+            *link = timer->link;
+            return true;
+        }
+    }
+    return false;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return now_us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return t / 1000;
+}
+
+uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return t + us;
+}
+
+absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) {
+    return t + (uint64_t) ms * 1000;
+}
+
+absolute_time_t make_timeout_time_us(uint64_t us) {
+    return now_us + us;
+}
+
+absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return now_us + (uint64_t) ms * 1000;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t) (to - from);
+}
+
+bool time_reached(absolute_time_t t) {
+    return now_us >= t;
+}
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t) now_us;
+}
+
+void sleep_us(uint64_t us) {
+    hal_time_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    hal_time_advance_us((uint64_t) ms * 1000);
+}
+
+void tight_loop_contents(void) {
+    hal_time_advance_us(1);
+}
+
+void sleep_until(absolute_time_t t) {
+    if (t > now_us)
+        hal_time_advance_us(t - now_us);
+}
+
+// Sem outras fontes de evento no computador, a espera sempre vai até o prazo; com
+// os dois núcleos ativos, o que tiver o prazo mais próximo roda primeiro
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    core_wake[current_core] = timeout_timestamp;
+    if (core1_launched && core_wake[1 - current_core] < timeout_timestamp) {
+        uint self = current_core;
+        current_core = 1 - self;
+        swapcontext(&core_contexts[self], &core_contexts[current_core]);
+    }
+    sleep_until(timeout_timestamp);
+    return true;
+}
+
+static void hal_core1_start(void) {
+    core1_entry();
+    fprintf(stderr, "hal: a função do núcleo 1 retornou\n");
+    exit(1);
+}
+
+// O núcleo 1 começa na primeira vez que o núcleo 0 dormir
+void multicore_launch_core1(void (*entry)(void)) {
+    core1_entry = entry;
+    getcontext(&core_contexts[1]);
+    core_contexts[1].uc_stack.ss_sp = malloc(HAL_CORE1_STACK);
+    core_contexts[1].uc_stack.ss_size = HAL_CORE1_STACK;
+    core_contexts[1].uc_link = NULL;
+    makecontext(&core_contexts[1], hal_core1_start, 0);
+    core_wake[1] = now_us;
+    core1_launched = true;
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+// A saída USB vai para o arquivo definido por hal_usb_set_output, sem tradução de \n
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void) cr_translation;
+    if (!usb_output)
+        return len;
+    fwrite(s, 1, len, usb_output);
+    if (newline)
+        fputc('\n', usb_output);
+    return len;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    (void) timeout_us;
+    if (!usb_input || !*usb_input)
+        return PICO_ERROR_TIMEOUT;
+    return (unsigned char) *usb_input++;
+}
+
+bool stdio_usb_connected(void) {
+    return usb_output != NULL;
+}
+
+void hal_usb_set_output(FILE *file) {
+    usb_output = file;
+}
+
+void hal_usb_set_input(const char *chars) {
+    usb_input = chars;
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void) status;
+}
+
+// GPIO
+
+void gpio_init(uint gpio) {
+    gpio_values[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    (void) gpio;
+    (void) out;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void) gpio;
+    (void) fn;
+}
+
+void gpio_pull_up(uint gpio) {
+    gpio_values[gpio] = true;
+}
+
+void gpio_put(uint gpio, bool value) {
+    gpio_values[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return gpio_values[gpio];
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    if (enabled)
+        gpio_irq_events[gpio] |= events;
+    else
+        gpio_irq_events[gpio] &= ~events;
+    gpio_callback = callback;
+}
+
+void hal_gpio_set_input(uint gpio, bool value) {
+    bool previous = gpio_values[gpio];
+    uint32_t event = 0;
+
+    gpio_values[gpio] = value;
+    if (previous && !value)
+        event = GPIO_IRQ_EDGE_FALL;
+    else if (!previous && value)
+        event = GPIO_IRQ_EDGE_RISE;
+
+    if (gpio_callback && (gpio_irq_events[gpio] & event))
+        gpio_callback(gpio, event);
+}
+
+// ADC
+
+bool hal_adc_load_trace(const char *path) {
+    FILE *file = fopen(path, "r");
+    unsigned int y, x;
+    size_t capacity = 1024;
+
+    if (!file)
+        return false;
+
+    free(adc_trace);
+    adc_trace = malloc(capacity * sizeof(*adc_trace));
+    adc_trace_len = 0;
+    while (fscanf(file, "%u %u", &y, &x) == 2) {
+        if (adc_trace_len == capacity) {
+            capacity *= 2;
+            adc_trace = realloc(adc_trace, capacity * sizeof(*adc_trace));
+        }
+        adc_trace[adc_trace_len][0] = y & 0xFFF;
+        adc_trace[adc_trace_len][1] = x & 0xFFF;
+        ++adc_trace_len;
+    }
+    fclose(file);
+    adc_trace_pos[0] = adc_trace_pos[1] = 0;
+    return adc_trace_len > 0;
+}
+
+void hal_adc_set_value(uint channel, uint16_t value) {
+    adc_values[channel] = value & 0xFFF;
+}
+
+uint64_t hal_adc_conversions(void) {
+    return adc_conversions;
+}
+
+// Função que realiza uma conversão no canal selecionado (o arquivo, se carregado, tem prioridade)
+static uint16_t hal_adc_convert(uint channel) {
+    ++adc_conversions;
+    if (adc_trace_len > 0 && channel < 2)
+        return adc_trace[adc_trace_pos[channel]++ % adc_trace_len][channel];
+    return adc_values[channel];
+}
+
+void adc_init(void) {
+    adc_input = 0;
+    adc_round_robin = 0;
+    adc_running = false;
+}
+
+void adc_gpio_init(uint gpio) {
+    (void) gpio;
+}
+
+void adc_select_input(uint input) {
+    adc_input = input;
+}
+
+uint16_t adc_read(void) {
+    hal_time_advance_us(2); // uma conversão leva 96 ciclos de 48 MHz
+    return hal_adc_convert(adc_input);
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc_round_robin = input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void) en;
+    (void) dreq_thresh;
+    (void) err_in_fifo;
+    (void) byte_shift;
+    adc_fifo_dreq = dreq_en;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    adc_clkdiv = clkdiv;
+}
+
+void adc_run(bool run) {
+    adc_running = run;
+    adc_time_rest = 0;
+}
+
+void adc_fifo_drain(void) {
+}
+
+// DMA
+
+static void hal_dma_trigger(uint channel);
+static void hal_pio_word(PIO pio, uint sm, uint16_t word);
+
+// Função que copia um elemento de uma transferência e avança os endereços do canal
+static void hal_dma_transfer_one(uint channel, uint32_t value) {
+    dma_channel_hw_t *hw = &dma_hw->ch[channel];
+    dma_channel_config *config = &dma_channels[channel].config;
+    uint size = 1u << config->size;
+    uintptr_t target = hw->write_addr;
+
+    if (hw->write_addr == (uintptr_t) &i2c_get_hw(i2c0)->data_cmd ||
+        hw->write_addr == (uintptr_t) &i2c_get_hw(i2c1)->data_cmd) {
+        i2c_inst_t *i2c = hw->write_addr == (uintptr_t) &i2c_get_hw(i2c0)->data_cmd ? i2c0 : i2c1;
+        i2c_pending[i2c_pending_len++] = value & 0xFF;
+        if ((value & I2C_IC_DATA_CMD_STOP_BITS) || i2c_pending_len == sizeof(i2c_pending)) {
+            i2c_write_blocking(i2c, i2c->hw.tar, i2c_pending, i2c_pending_len, false);
+            i2c_pending_len = 0;
+        }
+    } else if (hw->write_addr >= (uintptr_t) &pio0->txf[0] && hw->write_addr <= (uintptr_t) &pio0->txf[NUM_PIO_STATE_MACHINES - 1]) {
+        hal_pio_word(pio0, (hw->write_addr - (uintptr_t) &pio0->txf[0]) / sizeof(uint32_t), value);
+    } else if (hw->write_addr >= (uintptr_t) &pio1->txf[0] && hw->write_addr <= (uintptr_t) &pio1->txf[NUM_PIO_STATE_MACHINES - 1]) {
+        hal_pio_word(pio1, (hw->write_addr - (uintptr_t) &pio1->txf[0]) / sizeof(uint32_t), value);
+    } else {
+        memcpy((void *) hw->write_addr, &value, size);
+    }
+
+    if (config->read_increment)
+        hw->read_addr += size;
+    if (config->write_increment) {
+        uintptr_t next = hw->write_addr + size;
+        if (config->ring_write && config->ring_bits) {
+            uintptr_t mask = ((uintptr_t) 1 << config->ring_bits) - 1;
+            next = (hw->write_addr & ~mask) | (next & mask);
+        }
+        hw->write_addr = next;
+    }
+
+    // Escrever no registrador de disparo de outro canal o reinicia (usado em encadeamentos)
+    for (uint other = 0; other < NUM_DMA_CHANNELS; ++other) {
+        if (target == (uintptr_t) &dma_hw->ch[other].al1_transfer_count_trig) {
+            dma_channels[other].reload = dma_hw->ch[other].al1_transfer_count_trig;
+            hal_dma_trigger(other);
+        }
+    }
+
+    if (--hw->transfer_count == 0) {
+        dma_channels[channel].busy = false;
+        if (config->chain_to != channel)
+            hal_dma_trigger(config->chain_to);
+    }
+}
+
+// Função que lê o elemento da origem de um canal
+static uint32_t hal_dma_read(uint channel) {
+    dma_channel_hw_t *hw = &dma_hw->ch[channel];
+    uint32_t value = 0;
+    memcpy(&value, (const void *) hw->read_addr, 1u << dma_channels[channel].config.size);
+    return value;
+}
+
+// Função que indica se o canal é pacejado por um temporizador de DMA
+static bool hal_dma_timer_paced(uint channel) {
+    uint dreq = dma_channels[channel].config.dreq;
+    return dreq >= DREQ_DMA_TIMER0 && dreq < DREQ_DMA_TIMER0 + NUM_DMA_TIMERS;
+}
+
+// Função que indica se o canal é pacejado pela FIFO TX do I2C ou de uma máquina PIO
+static bool hal_dma_bus_paced(uint channel) {
+    uint dreq = dma_channels[channel].config.dreq;
+    return dreq == i2c_get_dreq(i2c0, true) || dreq == i2c_get_dreq(i2c1, true) ||
+           (dreq < NUM_PIOS * 8 && !(dreq & 4)); // pio_get_dreq(pio, sm, true)
+}
+
+// Função que inicia um canal; canais sem DREQ do ADC, de temporizador ou do barramento
+// transferem tudo imediatamente
+static void hal_dma_trigger(uint channel) {
+    dma_channel_state_t *state = &dma_channels[channel];
+
+    dma_hw->ch[channel].transfer_count = state->reload;
+    if (state->reload == 0)
+        return;
+    state->busy = true;
+    state->timer_rest = 0;
+    state->bus_rest_ns = 0;
+    if (state->config.dreq == DREQ_ADC || hal_dma_timer_paced(channel) || hal_dma_bus_paced(channel))
+        return; // avança com o tempo simulado em hal_time_advance_us
+
+    while (state->busy)
+        hal_dma_transfer_one(channel, hal_dma_read(channel));
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+        if (!dma_channels[channel].claimed) {
+            dma_channels[channel].claimed = true;
+            return channel;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "hal: nenhum canal DMA livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    dma_channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config config = {
+        .size = DMA_SIZE_32,
+        .read_increment = true,
+        .write_increment = false,
+        .ring_write = false,
+        .ring_bits = 0,
+        .dreq = DREQ_FORCE,
+        .chain_to = channel,
+    };
+    return config;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->read_increment = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->write_increment = incr;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    c->ring_write = write;
+    c->ring_bits = size_bits;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->chain_to = chain_to;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint32_t transfer_count, bool trigger) {
+    dma_channels[channel].config = *config;
+    dma_hw->ch[channel].write_addr = (uintptr_t) write_addr;
+    dma_hw->ch[channel].read_addr = (uintptr_t) read_addr;
+    dma_hw->ch[channel].transfer_count = transfer_count;
+    dma_channels[channel].reload = transfer_count;
+    if (trigger)
+        hal_dma_trigger(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    dma_hw->ch[channel].read_addr = (uintptr_t) read_addr;
+    dma_hw->ch[channel].transfer_count = transfer_count;
+    dma_channels[channel].reload = transfer_count;
+    hal_dma_trigger(channel);
+}
+
+void dma_channel_start(uint channel) {
+    hal_dma_trigger(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    dma_channels[channel].busy = false;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return dma_channels[channel].busy;
+}
+
+int dma_claim_unused_timer(bool required) {
+    for (uint timer = 0; timer < NUM_DMA_TIMERS; ++timer) {
+        if (!dma_timers[timer].claimed) {
+            dma_timers[timer].claimed = true;
+            return timer;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "hal: nenhum temporizador de DMA livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void dma_timer_set_fraction(uint timer, uint16_t numerator, uint16_t denominator) {
+    dma_timers[timer].numerator = numerator;
+    dma_timers[timer].denominator = denominator;
+}
+
+uint dma_get_timer_dreq(uint timer_num) {
+    return DREQ_DMA_TIMER0 + timer_num;
+}
+
+// Função que avança os canais pacejados por temporizador: uma transferência a cada
+// denominador/numerador ciclos do clock do sistema
+static void hal_dma_timers_run_for(uint64_t us) {
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+        dma_channel_state_t *state = &dma_channels[channel];
+        if (!state->busy || !hal_dma_timer_paced(channel))
+            continue;
+
+        dma_timer_state_t *timer = &dma_timers[state->config.dreq - DREQ_DMA_TIMER0];
+        if (timer->denominator == 0)
+            continue;
+        uint64_t cycles = state->timer_rest + us * (SYS_CLK_HZ / 1000000) * timer->numerator;
+        uint64_t count = cycles / timer->denominator;
+        state->timer_rest = cycles % timer->denominator;
+        while (count-- && state->busy)
+            hal_dma_transfer_one(channel, hal_dma_read(channel));
+    }
+}
+
+// Função que retorna a duração no barramento (ns) do próximo elemento de um canal no
+// ritmo do I2C ou do PIO: 9 bits por byte (mais o endereço no início de cada transação
+// I2C); no PIO, 32 ciclos por bit e 8 por palavra de instruções de START/STOP
+static uint64_t hal_dma_bus_cost_ns(uint channel, uint32_t value) {
+    uintptr_t target = dma_hw->ch[channel].write_addr;
+
+    if (target == (uintptr_t) &i2c_get_hw(i2c0)->data_cmd || target == (uintptr_t) &i2c_get_hw(i2c1)->data_cmd) {
+        i2c_inst_t *i2c = target == (uintptr_t) &i2c_get_hw(i2c0)->data_cmd ? i2c0 : i2c1;
+        uint64_t bits = i2c_pending_len == 0 ? 18 : 9;
+        return i2c->baudrate ? bits * 1000000000ull / i2c->baudrate : 0;
+    }
+
+    PIO pio = target >= (uintptr_t) &pio1->txf[0] && target <= (uintptr_t) &pio1->txf[NUM_PIO_STATE_MACHINES - 1] ? pio1 : pio0;
+    hal_pio_sm_t *state = &pio_sms[pio->index][(target - (uintptr_t) &pio->txf[0]) / sizeof(uint32_t)];
+    uint64_t cycles = (state->escape || (value & 0xFFFF) >> 10) ? 8 : 9 * 32;
+    return (uint64_t) (cycles * state->clkdiv * 1000000000.0 / SYS_CLK_HZ);
+}
+
+// Função que avança os canais no ritmo do barramento: cada elemento sai quando o tempo
+// do anterior termina e o relógio marca o fim de cada um durante a entrega (o callback
+// do I2C vê o instante do último byte), sem bloquear o núcleo que iniciou o envio
+static void hal_dma_bus_run_for(uint64_t us) {
+    uint64_t start = now_us;
+
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+        dma_channel_state_t *state = &dma_channels[channel];
+        if (!state->busy || !hal_dma_bus_paced(channel))
+            continue;
+
+        state->bus_rest_ns += us * 1000;
+        while (state->busy) {
+            uint32_t value = hal_dma_read(channel);
+            uint64_t cost = hal_dma_bus_cost_ns(channel, value);
+            if (cost > state->bus_rest_ns)
+                break;
+            state->bus_rest_ns -= cost;
+            now_us = start + (us * 1000 > state->bus_rest_ns ? (us * 1000 - state->bus_rest_ns) / 1000 : 0);
+            bus_paced = true;
+            hal_dma_transfer_one(channel, value);
+            bus_paced = false;
+        }
+        if (!state->busy)
+            state->bus_rest_ns = 0;
+        now_us = start;
+    }
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    while (dma_channels[channel].busy)
+        tight_loop_contents();
+}
+
+// Função que simula o ADC em modo contínuo durante um intervalo: gera as conversões
+// da taxa configurada e as entrega ao canal DMA pacejado pelo ADC
+static void hal_adc_run_for(uint64_t us) {
+    if (!adc_running)
+        return;
+
+    // Período de amostragem = (1 + div) ciclos de 48 MHz, no mínimo 96 ciclos
+    uint64_t period_cycles = adc_clkdiv < 95.0f ? 96 : (uint64_t) (adc_clkdiv + 1.0f);
+    uint64_t cycles = adc_time_rest + us * 48;
+    uint64_t count = cycles / period_cycles;
+    adc_time_rest = cycles % period_cycles;
+
+    for (uint64_t i = 0; i < count; ++i) {
+        uint16_t sample = hal_adc_convert(adc_input);
+        adc_hw->fifo = sample;
+
+        // Avança o round robin para o próximo canal habilitado
+        if (adc_round_robin) {
+            do {
+                adc_input = (adc_input + 1) % 5;
+            } while (!(adc_round_robin & (1u << adc_input)));
+        }
+
+        if (!adc_fifo_dreq)
+            continue;
+        for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+            if (dma_channels[channel].busy && dma_channels[channel].config.dreq == DREQ_ADC) {
+                hal_dma_transfer_one(channel, sample);
+                break;
+            }
+        }
+    }
+}
+
+// I2C
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    i2c->hw.status = I2C_IC_STATUS_TFE_BITS;
+    return baudrate;
+}
+
+// Função que contabiliza uma transação no barramento (I2C ou PIO), avança o relógio
+// pela sua duração e a repassa ao callback
+static void hal_bus_write(uint8_t addr, const uint8_t *src, size_t len, uint64_t duration_us) {
+    hal_i2c_transaction_t transaction = {.address = addr, .data = src, .len = len};
+
+    if (!bus_paced)
+        hal_time_advance_us(duration_us);
+    i2c_bytes += len + 1;
+    ++i2c_transactions;
+    if (i2c_callback)
+        i2c_callback(&transaction, i2c_context);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void) nostop;
+
+    // A transação bloqueia por 9 bits (8 de dados e ACK) por byte, contando o endereço
+    hal_bus_write(addr, src, len, i2c->baudrate ? (len + 1) * 9 * 1000000ull / i2c->baudrate : 0);
+    return len;
+}
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    return &i2c->hw;
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 32 + 2 * i2c->index + (is_tx ? 0 : 1);
+}
+
+void hal_i2c_set_callback(hal_i2c_callback_t callback, void *context) {
+    i2c_callback = callback;
+    i2c_context = context;
+}
+
+uint64_t hal_i2c_bytes(void) {
+    return i2c_bytes;
+}
+
+uint64_t hal_i2c_transactions(void) {
+    return i2c_transactions;
+}
+
+void hal_i2c_reset_counters(void) {
+    i2c_bytes = 0;
+    i2c_transactions = 0;
+}
+
+// PIO
+
+// Função que interpreta uma palavra da FIFO TX do programa I2C: sequências de
+// instruções (2 = START, 3 = STOP) ou um byte de dados no campo Data
+static void hal_pio_word(PIO pio, uint sm, uint16_t word) {
+    hal_pio_sm_t *state = &pio_sms[pio->index][sm];
+
+    pio->fdebug |= 1u << (PIO_FDEBUG_TXSTALL_LSB + sm); // consumida na hora: a máquina volta a esperar
+
+    if (state->escape) {
+        if (--state->escape > 0)
+            return;
+        if (state->escape_len == 2) {
+            state->len = 0;
+        } else if (state->escape_len == 3 && state->len > 0) {
+            // 32 ciclos de PIO por bit: 9 bits por byte (com o endereço) e 5 instruções
+            // de 8 ciclos no START e no STOP
+            uint64_t cycles = (uint64_t) state->len * 9 * 32 + 5 * 8;
+            uint64_t duration_us = (uint64_t) (cycles * state->clkdiv * 1000000.0 / SYS_CLK_HZ);
+            hal_bus_write(state->bytes[0] >> 1, &state->bytes[1], state->len - 1, duration_us);
+            state->len = 0;
+        }
+        return;
+    }
+
+    uint count = word >> 10;
+    if (count) {
+        state->escape = state->escape_len = count + 1;
+        return;
+    }
+    if (state->len < sizeof(state->bytes))
+        state->bytes[state->len++] = (word >> 1) & 0xFF;
+}
+
+pio_sm_config pio_get_default_sm_config(void) {
+    return (pio_sm_config){.clkdiv = 1.0f};
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    (void) c;
+    (void) bit_count;
+    (void) optional;
+    (void) pindirs;
+}
+
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    (void) c;
+    (void) out_base;
+    (void) out_count;
+}
+
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    (void) c;
+    (void) set_base;
+    (void) set_count;
+}
+
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base) {
+    (void) c;
+    (void) in_base;
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    (void) c;
+    (void) sideset_base;
+}
+
+void sm_config_set_jmp_pin(pio_sm_config *c, uint pin) {
+    (void) c;
+    (void) pin;
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    (void) c;
+    (void) shift_right;
+    (void) autopull;
+    (void) pull_threshold;
+}
+
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) {
+    (void) shift_right;
+    (void) push_threshold;
+    c->autopush = autopush;
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    c->clkdiv = div;
+}
+
+uint pio_get_index(PIO pio) {
+    return pio->index;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    uint offset = pio_program_end[pio->index];
+    if (offset + program->length > 32) {
+        fprintf(stderr, "hal: sem espaço na memória de instruções do PIO\n");
+        abort();
+    }
+    pio_program_end[pio->index] += program->length;
+    return offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; ++sm) {
+        if (!pio_sms[pio->index][sm].claimed) {
+            pio_sms[pio->index][sm].claimed = true;
+            return sm;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "hal: nenhuma máquina de estado PIO livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+    (void) pio;
+    (void) pin;
+}
+
+void gpio_set_oeover(uint gpio, uint value) {
+    (void) gpio;
+    (void) value;
+}
+
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask) {
+    (void) pio;
+    (void) sm;
+    (void) pin_values;
+    (void) pin_mask;
+}
+
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t pin_dirs, uint32_t pin_mask) {
+    (void) pio;
+    (void) sm;
+    (void) pin_dirs;
+    (void) pin_mask;
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    (void) initial_pc;
+
+    // O programa I2C lê SDA com "in" a cada bit e nada lê a FIFO RX: com autopush, a
+    // máquina pararia com a FIFO cheia após 4 bytes
+    if (config->autopush) {
+        fprintf(stderr, "hal: autopush na máquina %u do PIO %u sem leitura da FIFO RX\n", sm, pio->index);
+        abort();
+    }
+    pio_sms[pio->index][sm].clkdiv = config->clkdiv;
+    pio_sms[pio->index][sm].escape = 0;
+    pio_sms[pio->index][sm].len = 0;
+    pio->fdebug |= 1u << (PIO_FDEBUG_TXSTALL_LSB + sm);
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    (void) pio;
+    (void) sm;
+    (void) enabled;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return pio->index * 8 + (is_tx ? 0 : 4) + sm;
+}
+
+// Sem dispositivos que respondam NAK, a máquina nunca para na IRQ de erro
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num) {
+    (void) pio;
+    (void) pio_interrupt_num;
+    return false;
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num) {
+    (void) pio;
+    (void) pio_interrupt_num;
+}
+
+// A máquina simulada consome cada palavra na hora: a FIFO só tem palavras enquanto um
+// canal DMA as entrega no ritmo do barramento; vazia, a máquina está parada à espera
+// da próxima (TXSTALL volta a ser marcado)
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+        if (dma_channels[channel].busy && dma_hw->ch[channel].write_addr == (uintptr_t) &pio->txf[sm])
+            return false;
+    }
+    pio->fdebug |= 1u << (PIO_FDEBUG_TXSTALL_LSB + sm);
+    return true;
+}
+
+// A palavra de 16 bits vai nos bits altos (deslocamento para a esquerda)
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    hal_pio_word(pio, sm, data >> 16);
+}
+
+void pio_sm_drain_tx_fifo(PIO pio, uint sm) {
+    (void) pio;
+    (void) sm;
+}
+
+void pio_sm_exec(PIO pio, uint sm, uint instr) {
+    (void) pio;
+    (void) sm;
+    (void) instr;
+}
+
+// Clocks
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    (void) clk_index;
+    return SYS_CLK_HZ;
+}
+
+// SysTick
+
+// Função que atualiza o contador decrescente do SysTick: no computador ele conta o tempo
+// real de execução em ciclos de SYS_CLK_HZ (o tempo simulado não avança durante o
+// processamento), o que mede o computador, não o RP2040
+systick_hw_t *hal_systick(void) {
+    static systick_hw_t regs;
+    struct timespec now;
+
+    if (regs.csr & M0PLUS_SYST_CSR_ENABLE_BITS) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint64_t cycles = ((uint64_t) now.tv_sec * 1000000000u + now.tv_nsec) * (SYS_CLK_HZ / 1000000) / 1000;
+        regs.cvr = regs.rvr - (uint32_t) (cycles % ((uint64_t) regs.rvr + 1));
+    }
+    return &regs;
+}
+
+// PWM
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1) & 7;
+}
+
+uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1;
+}
+
+void pwm_set_clkdiv(uint slice_num, float divider) {
+    pwm_hw->slice[slice_num].div = (uint32_t) (divider * 16.0f); // 8.4 bits
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    pwm_hw->slice[slice_num].top = wrap;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    volatile uint32_t *cc = &pwm_hw->slice[pwm_gpio_to_slice_num(gpio)].cc;
+    uint shift = pwm_gpio_to_channel(gpio) ? 16 : 0;
+    *cc = (*cc & ~(0xFFFFu << shift)) | ((uint32_t) level << shift);
+    ++pwm_writes[gpio];
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    (void) slice_num;
+    (void) enabled;
+}
+
+uint16_t hal_pwm_level(uint gpio) {
+    return pwm_hw->slice[pwm_gpio_to_slice_num(gpio)].cc >> (pwm_gpio_to_channel(gpio) ? 16 : 0);
+}
+
+uint64_t hal_pwm_writes(uint gpio) {
+    return pwm_writes[gpio];
+}
+
+// Flash
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    memset(&hal_flash[flash_offs], 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        hal_flash[flash_offs + i] &= data[i]; // programar só leva bits de 1 para 0
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void) enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
+
+bool flash_safe_execute_core_init(void) {
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Controle da HAL simulada (somente no computador)
+
+// Uma transação I2C capturada (endereço e bytes enviados, sem o byte de endereço)
+typedef struct {
+  uint8_t address;
+  const uint8_t *data;
+  size_t len;
+} hal_i2c_transaction_t;
+
+typedef void (*hal_i2c_callback_t)(const hal_i2c_transaction_t *transaction, void *context);
+
+// Tempo simulado: avança o relógio e processa o que o hardware faria nesse intervalo
+// (conversões do ADC em modo contínuo e transferências DMA pacejadas pelo ADC ou
+// pelos temporizadores de DMA)
+void hal_time_advance_us(uint64_t us);
+
+// Fim da simulação: ao chegar ao instante us o programa termina com exit(0),
+// executando as funções registradas com atexit (relatórios)
+void hal_time_set_end(uint64_t us);
+
+// ADC: as amostras vêm de um arquivo texto com uma linha "<canal 0> <canal 1>" por
+// instante; sem arquivo, cada canal devolve o valor fixo definido por hal_adc_set_value
+bool hal_adc_load_trace(const char *path);
+void hal_adc_set_value(uint channel, uint16_t value);
+uint64_t hal_adc_conversions(void);
+
+// I2C: cada transação (bloqueante, via DMA ou pelo programa I2C do PIO) é contabilizada
+// e repassada ao callback
+void hal_i2c_set_callback(hal_i2c_callback_t callback, void *context);
+uint64_t hal_i2c_bytes(void);        // bytes no barramento, incluindo o byte de endereço
+uint64_t hal_i2c_transactions(void);
+void hal_i2c_reset_counters(void);
+
+// PWM: nível atual de cada GPIO (escrito pela CPU ou por DMA) e número de escritas da CPU
+uint16_t hal_pwm_level(uint gpio);
+uint64_t hal_pwm_writes(uint gpio);
+
+// USB: a saída binária (stdio_put_string) vai para file, que conta como host conectado
+// (NULL desconecta); chars é a entrada lida por getchar_timeout_us, um caractere por vez
+void hal_usb_set_output(FILE *file);
+void hal_usb_set_input(const char *chars);
+
+// GPIO: muda o nível de uma entrada e dispara o callback de interrupção configurado
+void hal_gpio_set_input(uint gpio, bool value);
+
+#endif
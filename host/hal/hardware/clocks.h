@@ -0,0 +1,14 @@
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+#define SYS_CLK_HZ 125000000
+
+enum clock_index {
+  clk_sys = 5
+};
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif
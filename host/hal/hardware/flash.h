@@ -0,0 +1,16 @@
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+// A flash simulada é um vetor em RAM mapeado em XIP_BASE
+extern uint8_t hal_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t) hal_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
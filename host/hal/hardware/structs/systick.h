@@ -0,0 +1,20 @@
+#ifndef HOST_HARDWARE_STRUCTS_SYSTICK_H
+#define HOST_HARDWARE_STRUCTS_SYSTICK_H
+
+#include "pico/stdlib.h"
+
+#define M0PLUS_SYST_CSR_ENABLE_BITS 0x00000001
+#define M0PLUS_SYST_CSR_CLKSOURCE_BITS 0x00000004
+
+typedef struct {
+  volatile uint32_t csr;
+  volatile uint32_t rvr;
+  volatile uint32_t cvr;
+  volatile uint32_t calib;
+} systick_hw_t;
+
+// Cada acesso atualiza a contagem a partir do relógio do computador
+systick_hw_t *hal_systick(void);
+#define systick_hw (hal_systick())
+
+#endif
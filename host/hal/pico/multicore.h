@@ -0,0 +1,10 @@
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+// O núcleo 1 roda em um contexto próprio da mesma thread; os núcleos se alternam
+// quando um deles dorme (best_effort_wfe_or_timeout), sempre em ordem de prazo
+void multicore_launch_core1(void (*entry)(void));
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef HOST_PICO_STDIO_H
+#define HOST_PICO_STDIO_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+bool stdio_init_all(void);
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif
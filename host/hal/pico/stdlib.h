@@ -0,0 +1,88 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// HAL simulada para compilar os módulos no computador (x86 Linux).
+// Reproduz apenas a parte do SDK do Raspberry Pi Pico usada pelo projeto; o tempo
+// é simulado e só avança com as funções sleep_* ou hal_time_advance_us().
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t; // microssegundos desde o boot simulado
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#define NUM_BANK0_GPIOS 30
+
+// GPIO
+#define GPIO_IN false
+#define GPIO_OUT true
+
+enum gpio_function {
+  GPIO_FUNC_SIO = 5,
+  GPIO_FUNC_I2C = 3,
+  GPIO_FUNC_PWM = 4,
+  GPIO_FUNC_NULL = 0x1f
+};
+
+enum gpio_irq_level {
+  GPIO_IRQ_LEVEL_LOW = 0x1u,
+  GPIO_IRQ_LEVEL_HIGH = 0x2u,
+  GPIO_IRQ_EDGE_FALL = 0x4u,
+  GPIO_IRQ_EDGE_RISE = 0x8u
+};
+
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_pull_up(uint gpio);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback);
+
+// Tempo
+absolute_time_t get_absolute_time(void);
+uint32_t to_ms_since_boot(absolute_time_t t);
+uint64_t to_us_since_boot(absolute_time_t t);
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us);
+absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms);
+absolute_time_t make_timeout_time_us(uint64_t us);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+bool time_reached(absolute_time_t t);
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+#define at_the_end_of_time ((absolute_time_t) INT64_MAX)
+
+// Espera ativa: avança o tempo simulado para que o hardware (DMA, ADC) progrida
+void tight_loop_contents(void);
+
+// Temporizadores repetitivos (disparados durante o avanço do tempo simulado)
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+struct repeating_timer {
+  int64_t delay_us;
+  absolute_time_t next;
+  repeating_timer_callback_t callback;
+  void *user_data;
+  repeating_timer_t *link;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+#include "hal.h"
+
+#endif
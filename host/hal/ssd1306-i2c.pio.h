@@ -0,0 +1,59 @@
+// Equivalente ao cabeçalho que o pioasm gera a partir de include/ssd1306-i2c.pio
+// (a HAL simulada não executa o programa: decodifica as palavras da FIFO TX)
+
+#pragma once
+
+#include "hardware/pio.h"
+
+#define ssd1306_i2c_wrap_target 12
+#define ssd1306_i2c_wrap 17
+#define ssd1306_i2c_offset_entry_point 12u
+
+static const uint16_t ssd1306_i2c_program_instructions[] = {
+    0x008c, //  0: jmp    y--, 12
+    0xc030, //  1: irq    wait 0 rel
+    0xe027, //  2: set    x, 7
+    0x6781, //  3: out    pindirs, 1             [7]
+    0xba42, //  4: nop                    side 1 [2]
+    0x24a1, //  5: wait   1 pin, 1               [4]
+    0x4701, //  6: in     pins, 1                [7]
+    0x1743, //  7: jmp    x--, 3          side 0 [7]
+    0x6781, //  8: out    pindirs, 1             [7]
+    0xbf42, //  9: nop                    side 1 [7]
+    0x27a1, // 10: wait   1 pin, 1               [7]
+    0x12c0, // 11: jmp    pin, 0          side 0 [2]
+    0x6026, // 12: out    x, 6
+    0x6041, // 13: out    y, 1
+    0x0022, // 14: jmp    !x, 2
+    0x6060, // 15: out    null, 32
+    0x60f0, // 16: out    exec, 16
+    0x0050, // 17: jmp    x--, 16
+};
+
+static const struct pio_program ssd1306_i2c_program = {
+    .instructions = ssd1306_i2c_program_instructions,
+    .length = 18,
+    .origin = -1,
+};
+
+static inline pio_sm_config ssd1306_i2c_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + ssd1306_i2c_wrap_target, offset + ssd1306_i2c_wrap);
+    sm_config_set_sideset(&c, 2, true, true);
+    return c;
+}
+
+static const uint16_t set_scl_sda_program_instructions[] = {
+    0xf780, //  0: set    pindirs, 0      side 0 [7]
+    0xf781, //  1: set    pindirs, 1      side 0 [7]
+    0xff80, //  2: set    pindirs, 0      side 1 [7]
+    0xff81, //  3: set    pindirs, 1      side 1 [7]
+};
+
+// Ordem da tabela set_scl_sda
+enum {
+  SSD1306_I2C_SC0_SD0 = 0,
+  SSD1306_I2C_SC0_SD1,
+  SSD1306_I2C_SC1_SD0,
+  SSD1306_I2C_SC1_SD1
+};
@@ -0,0 +1,233 @@
+// Reprodução determinística de uma gravação de entradas (include/trace.h) pelo
+// programa completo, com os dois núcleos: aquisição -> calibração -> PWM -> desenho
+// -> envio ao display. Ao fim da gravação imprime o relatório de desempenho.
+//
+//   conversorAD-replay entrada.trace                 reproduz a gravação
+//   conversorAD-replay --synthetic 10 saida.trace    gera uma gravação de 10 s
+//
+// As leituras gravadas alimentam os dois canais do ADC simulado e os botões são
+// acionados nos instantes gravados (o debounce acrescenta os mesmos 20 ms da placa).
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+#include "hal.h"
+#include "button.h"
+#include "joystick.h"
+#include "profile.h"
+#include "ssd1306.h"
+#include "trace.h"
+
+// Defines
+#define REPLAY_TICK_US 100          // resolução da aplicação dos eventos gravados
+#define REPLAY_TAIL_US 100000       // tempo simulado após o último evento
+#define REPLAY_MAX_FRAMES 200000
+#define SYNTHETIC_PERIOD_US 1000    // uma leitura por ciclo de controle
+
+// Quadro em medição: início do desenho e último byte enviado ao display até agora
+typedef struct {
+  uint64_t start_us, end_us;
+  bool open;
+} replay_frame_t;
+
+// Declaração de variáveis
+static trace_t trace;
+static trace_event_t pending;
+static bool has_pending;
+static uint64_t samples, buttons;
+static uint32_t frame_latency[REPLAY_MAX_FRAMES];
+static size_t frame_count;
+static replay_frame_t drawn, sending;       // último quadro desenhado e quadro ainda em envio
+static uint64_t control_cycles;
+static struct timespec wall_start;
+static FILE *report;
+
+int app_main(void);  // main de conversorAD-embarcatech.c
+extern ssd1306_t ssd; // display do programa
+
+// Funções
+
+// Função que aplica os eventos da gravação até o instante atual
+static bool replay_tick(repeating_timer_t *rt) {
+    while (has_pending && pending.time_us <= time_us_64()) {
+        if (pending.type == TRACE_SAMPLE) {
+            hal_adc_set_value(ADC_CHANNEL_0, pending.vry_value);
+            hal_adc_set_value(ADC_CHANNEL_1, pending.vrx_value);
+            ++samples;
+        } else {
+            hal_gpio_set_input(pending.gpio, !pending.pressed); // botões ativos em nível baixo
+            ++buttons;
+        }
+        has_pending = trace_next(&trace, &pending);
+    }
+    return true;
+}
+
+// Função que fecha um quadro: latência do início do desenho até o último byte enviado
+// ao display (ou até o fim do desenho, se nada mudou)
+static void replay_frame_close(replay_frame_t *frame) {
+    if (frame->open && frame_count < REPLAY_MAX_FRAMES)
+        frame_latency[frame_count++] = frame->end_us - frame->start_us;
+    frame->open = false;
+}
+
+// Função que abre um quadro ao fim de cada desenho e conta os ciclos de controle. O
+// quadro anterior cujo envio ainda não terminou continua aberto (o programa não inicia
+// outro envio enquanto isso) e recebe os bytes seguintes
+static void replay_profile(profile_stage_t stage, uint32_t duration_us) {
+    if (stage == PROFILE_DRAW) {
+        if (frame_count == 0 && !drawn.open)
+            hal_i2c_reset_counters(); // só o tráfego dos quadros, sem a inicialização
+        if (sending.open && ssd1306_flush_done(&ssd))
+            replay_frame_close(&sending);
+        if (drawn.open && !sending.open && !ssd1306_flush_done(&ssd))
+            sending = drawn;
+        else
+            replay_frame_close(&drawn);
+
+        drawn.end_us = time_us_64();
+        drawn.start_us = drawn.end_us - duration_us;
+        drawn.open = true;
+    } else if (stage == PROFILE_ACQUIRE) {
+        ++control_cycles;
+    }
+}
+
+// Função que marca o instante do último byte de cada transação do display; o DMA
+// entrega os bytes no ritmo do barramento, sem bloquear a tarefa do display
+static void replay_i2c(const hal_i2c_transaction_t *transaction, void *context) {
+    replay_frame_t *frame = sending.open ? &sending : &drawn;
+    if (frame->open)
+        frame->end_us = time_us_64();
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t count, unsigned pct) {
+    return count ? sorted[(count - 1) * pct / 100] : 0;
+}
+
+// Função que imprime o relatório ao fim da simulação (registrada com atexit)
+static void replay_report(void) {
+    struct timespec wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) * 1e-9;
+    double sim_s = time_us_64() * 1e-6;
+
+    replay_frame_close(&sending);
+    replay_frame_close(&drawn);
+    size_t frames = frame_count;
+    uint32_t *latency = frame_latency;
+    qsort(latency, frames, sizeof(uint32_t), compare_u32);
+
+    fprintf(report, "gravação: %llu leituras, %llu eventos de botão, %.2f s simulados\n",
+            (unsigned long long) samples, (unsigned long long) buttons, sim_s);
+    fprintf(report, "vazão: %llu ciclos de controle e %zu quadros em %.3f s de CPU "
+            "(%.0f ciclos/s, %.0f quadros/s, %.1fx o tempo real)\n",
+            (unsigned long long) control_cycles, frames, wall_s,
+            control_cycles / wall_s, frames / wall_s, sim_s / wall_s);
+    fprintf(report, "latência por quadro (desenho + envio até o último byte, us): "
+            "p50 %u  p90 %u  p99 %u  máx %u\n",
+            percentile(latency, frames, 50), percentile(latency, frames, 90),
+            percentile(latency, frames, 99), percentile(latency, frames, 100));
+    fprintf(report, "display: %llu bytes em %llu transações (%.1f bytes por quadro)\n",
+            (unsigned long long) hal_i2c_bytes(), (unsigned long long) hal_i2c_transactions(),
+            frames ? (double) hal_i2c_bytes() / frames : 0.0);
+}
+
+// Função que gera uma gravação determinística: o joystick descreve círculos e
+// espirais, com toques em A, um clique duplo em A (modo de taxa) e outro em SW (gráfico)
+static bool write_synthetic(const char *path, unsigned seconds) {
+    size_t capacity = (size_t) seconds * (1000000 / SYNTHETIC_PERIOD_US) * 6 + 4096;
+    uint8_t *buffer = malloc(capacity);
+    uint8_t header[TRACE_HEADER_SIZE];
+    static const struct { uint32_t ms; uint8_t gpio; bool pressed; } clicks[] = {
+        {1000, BUTTON_A_PIN, true}, {1100, BUTTON_A_PIN, false},     // LEDs desligados
+        {1600, BUTTON_A_PIN, true}, {1700, BUTTON_A_PIN, false},     // e religados
+        {2500, SW, true}, {2600, SW, false},                         // borda de corações
+        {4000, BUTTON_A_PIN, true}, {4080, BUTTON_A_PIN, false},     // clique duplo: modo de taxa
+        {4160, BUTTON_A_PIN, true}, {4240, BUTTON_A_PIN, false},
+        {6000, SW, true}, {6080, SW, false},                         // clique duplo: gráfico
+        {6160, SW, true}, {6240, SW, false},
+    };
+    size_t next_click = 0;
+
+    trace_init(&trace, buffer, capacity, 0);
+    for (uint32_t t = 0; t < seconds * 1000000u; t += SYNTHETIC_PERIOD_US) {
+        while (next_click < sizeof(clicks) / sizeof(clicks[0]) && clicks[next_click].ms * 1000 <= t) {
+            trace_record_button(&trace, clicks[next_click].ms * 1000, clicks[next_click].gpio, clicks[next_click].pressed);
+            ++next_click;
+        }
+        double phase = t * 1e-6 * 2 * M_PI * 0.5;
+        double radius = 1900 * (0.5 + 0.5 * sin(t * 1e-6 * 2 * M_PI * 0.1));
+        trace_record_sample(&trace, t, 2048 + (int) (radius * cos(phase)), 2048 + (int) (radius * sin(phase)));
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+    trace_header(&trace, header);
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(trace.data, 1, trace.len, file);
+    fclose(file);
+    fprintf(stderr, "%s: %zu bytes\n", path, sizeof(header) + trace.len);
+    free(buffer);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    static repeating_timer_t timer;
+
+    if (argc == 4 && strcmp(argv[1], "--synthetic") == 0)
+        return write_synthetic(argv[3], atoi(argv[2])) ? 0 : 1;
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <gravação> | --synthetic <segundos> <saída>\n", argv[0]);
+        return 2;
+    }
+
+    FILE *file = fopen(argv[1], "rb");
+    if (!file) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    uint8_t *data = malloc(size);
+    if (fread(data, 1, size, file) != (size_t) size || !trace_open(&trace, data, size)) {
+        fprintf(stderr, "%s: gravação inválida\n", argv[1]);
+        return 1;
+    }
+    fclose(file);
+
+    // O instante do último evento define o fim da simulação
+    trace_t scan = trace;
+    trace_event_t event;
+    uint32_t last_us = 0;
+    while (trace_next(&scan, &event))
+        last_us = event.time_us;
+
+    // O relatório vai para a saída padrão original; o printf do programa (relatórios
+    // periódicos do profile) é descartado
+    report = fdopen(dup(fileno(stdout)), "w");
+    freopen("/dev/null", "w", stdout);
+
+    hal_gpio_set_input(SW, true);
+    hal_gpio_set_input(BUTTON_A_PIN, true);
+    has_pending = trace_next(&trace, &pending);
+    add_repeating_timer_us(-REPLAY_TICK_US, replay_tick, NULL, &timer);
+    profile_set_callback(replay_profile);
+    hal_i2c_set_callback(replay_i2c, NULL);
+    hal_time_set_end((uint64_t) last_us + REPLAY_TAIL_US);
+    atexit(replay_report);
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    return app_main();
+}
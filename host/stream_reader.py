@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Lê os quadros binários do modo de envio pela USB e grava as amostras em CSV.
+
+Uso:
+    stream_reader.py /dev/ttyACM0 --mode r -o amostras.csv   # placa conectada
+    stream_reader.py captura.bin -o amostras.csv             # arquivo já capturado
+
+Cada linha do CSV é um par Y/X: sequence, timestamp_us (do primeiro par do quadro),
+index (posição do par no quadro), y, x, overrun. Quadros perdidos (saltos na
+sequência) e quadros corrompidos são contados e informados ao final.
+"""
+
+import argparse
+import csv
+import os
+import sys
+import termios
+import tty
+
+SYNC = b"\xa5\x5a"
+HEADER_SIZE = 10
+FLAG_OVERRUN = 0x80
+
+
+def fletcher16(data):
+    sum1 = sum2 = 0
+    for byte in data:
+        sum1 = (sum1 + byte) % 255
+        sum2 = (sum2 + sum1) % 255
+    return (sum2 << 8) | sum1
+
+
+def decode_frames(chunks, stats):
+    """Gera (type, sequence, timestamp, pares) a partir de blocos de bytes."""
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer += chunk
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                del buffer[:-1]  # mantém um possível primeiro byte de sincronismo
+                break
+            if start > 0:
+                stats["skipped_bytes"] += start
+                del buffer[:start]
+            if len(buffer) < HEADER_SIZE:
+                break
+            pairs = buffer[3]
+            size = HEADER_SIZE + 3 * pairs + 2
+            if len(buffer) < size:
+                break
+            frame = bytes(buffer[:size])
+            checksum = frame[-2] | (frame[-1] << 8)
+            if fletcher16(frame[2:-2]) != checksum:
+                stats["bad_frames"] += 1
+                del buffer[:2]  # procura o próximo sincronismo
+                continue
+            del buffer[:size]
+
+            sequence = frame[4] | (frame[5] << 8)
+            timestamp = int.from_bytes(frame[6:10], "little")
+            samples = []
+            for i in range(pairs):
+                b0, b1, b2 = frame[HEADER_SIZE + 3 * i:HEADER_SIZE + 3 * i + 3]
+                samples.append((b0 | ((b1 & 0x0F) << 8), (b1 >> 4) | (b2 << 4)))
+            yield frame[2], sequence, timestamp, samples
+
+
+def read_chunks(fd):
+    while True:
+        chunk = os.read(fd, 4096)
+        if not chunk:
+            return
+        yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="porta serial da placa ou arquivo capturado ('-' para a entrada padrão)")
+    parser.add_argument("--mode", choices=["r", "f"], help="modo a pedir à placa: r (bruto) ou f (filtrado)")
+    parser.add_argument("-o", "--output", help="arquivo CSV (padrão: saída padrão)")
+    parser.add_argument("-n", "--frames", type=int, default=0, help="para depois de N quadros (0 = sem limite)")
+    args = parser.parse_args()
+
+    fd = sys.stdin.fileno() if args.source == "-" else os.open(args.source, os.O_RDWR if args.mode else os.O_RDONLY)
+    is_tty = os.isatty(fd)
+    if is_tty:
+        tty.setraw(fd)
+        termios.tcflush(fd, termios.TCIFLUSH)
+    if args.mode:
+        os.write(fd, args.mode.encode())
+
+    output = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(output, lineterminator="\n")
+    writer.writerow(["sequence", "timestamp_us", "index", "y", "x", "overrun"])
+
+    stats = {"frames": 0, "lost_frames": 0, "bad_frames": 0, "skipped_bytes": 0}
+    last_sequence = None
+    try:
+        for frame_type, sequence, timestamp, samples in decode_frames(read_chunks(fd), stats):
+            if last_sequence is not None:
+                stats["lost_frames"] += (sequence - last_sequence - 1) & 0xFFFF
+            last_sequence = sequence
+            overrun = 1 if frame_type & FLAG_OVERRUN else 0
+            for index, (y, x) in enumerate(samples):
+                writer.writerow([sequence, timestamp, index, y, x, overrun])
+            stats["frames"] += 1
+            if args.frames and stats["frames"] >= args.frames:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if args.mode and is_tty:
+            os.write(fd, b"s")
+        if output is not sys.stdout:
+            output.close()
+
+    print("quadros: {frames}  perdidos: {lost_frames}  corrompidos: {bad_frames}  "
+          "bytes ignorados: {skipped_bytes}".format(**stats), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
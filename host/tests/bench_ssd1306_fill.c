@@ -0,0 +1,170 @@
+// Medição do desenho por faixas de página do ssd1306 (ssd1306_fill, ssd1306_fill_rect,
+// ssd1306_rect, ssd1306_hline e ssd1306_vline) contra as versões antigas, que desenhavam
+// pixel a pixel e ficam aqui como referência. Confere que os dois buffers ficam iguais
+// em RANDOM_SHAPES formas aleatórias dentro da tela e imprime o tempo médio de cada
+// operação em BENCH_RUNS chamadas. Os tempos são do relógio do computador em que o
+// teste roda, não ciclos do RP2040: servem para comparar as duas versões entre si.
+// Para tempos representativos, compile com -DCMAKE_BUILD_TYPE=Release
+
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "test.h"
+
+// Defines
+#define WIDTH 128
+#define HEIGHT 64
+#define RANDOM_SHAPES 20000
+#define BENCH_RUNS 20000
+
+typedef void (*draw_fn_t)(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value);
+
+// Declaração de variáveis
+static ssd1306_t ssd, reference;
+static uint32_t seed = 7;
+
+// Funções
+
+// Função que retorna um número pseudoaleatório de 0 a limit - 1
+static uint32_t random_below(uint32_t limit) {
+    seed = seed * 1664525 + 1013904223;
+    return (seed >> 8) % limit;
+}
+
+// Função que retorna o tempo do relógio do computador em nanossegundos
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Versões antigas, pixel a pixel
+
+// Função que preenche todo o display pixel a pixel
+static void reference_fill(ssd1306_t *ssd, bool value) {
+    for (uint8_t y = 0; y < ssd->height; ++y) {
+        for (uint8_t x = 0; x < ssd->width; ++x) {
+            ssd1306_pixel(ssd, x, y, value);
+        }
+    }
+}
+
+// Função que preenche um retângulo pixel a pixel
+static void reference_fill_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        for (uint8_t y = top; y < top + height; ++y)
+            ssd1306_pixel(ssd, x, y, value);
+    }
+}
+
+// Função que desenha a borda de um retângulo pixel a pixel
+static void reference_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        ssd1306_pixel(ssd, x, top, value);
+        ssd1306_pixel(ssd, x, top + height - 1, value);
+    }
+    for (uint8_t y = top; y < top + height; ++y) {
+        ssd1306_pixel(ssd, left, y, value);
+        ssd1306_pixel(ssd, left + width - 1, y, value);
+    }
+}
+
+// Função que desenha uma linha horizontal pixel a pixel (mesma assinatura das demais)
+static void reference_hline(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    for (uint8_t x = left; x <= left + width - 1; ++x)
+        ssd1306_pixel(ssd, x, top, value);
+}
+
+// Função que desenha uma linha vertical pixel a pixel
+static void reference_vline(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    for (uint8_t y = top; y <= top + height - 1; ++y)
+        ssd1306_pixel(ssd, left, y, value);
+}
+
+// Adaptadores das linhas atuais para a assinatura dos retângulos
+static void hline(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    ssd1306_hline(ssd, left, left + width - 1, top, value);
+}
+
+static void vline(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    ssd1306_vline(ssd, left, top, top + height - 1, value);
+}
+
+// Função que mede o tempo médio de uma forma desenhada BENCH_RUNS vezes
+static double bench(draw_fn_t draw, uint8_t top, uint8_t left, uint8_t width, uint8_t height) {
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < BENCH_RUNS; ++i)
+        draw(&ssd, top, left, width, height, i & 1);
+    return (double) (now_ns() - start) / BENCH_RUNS;
+}
+
+// Função que mede o preenchimento da tela inteira
+static double bench_fill(void (*fill)(ssd1306_t *ssd, bool value)) {
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < BENCH_RUNS; ++i)
+        fill(&ssd, i & 1);
+    return (double) (now_ns() - start) / BENCH_RUNS;
+}
+
+int main(int argc, char **argv) {
+    static const struct {
+        const char *name;
+        draw_fn_t draw, reference;
+    } ops[] = {
+        {"fill_rect", ssd1306_fill_rect, reference_fill_rect},
+        {"rect", ssd1306_rect, reference_rect},
+        {"hline", hline, reference_hline},
+        {"vline", vline, reference_vline},
+    };
+    const size_t op_count = sizeof(ops) / sizeof(ops[0]);
+
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+    ssd1306_init(&reference, WIDTH, HEIGHT, false, 0x3C, NULL);
+
+    // Conteúdo inicial aleatório, igual nos dois buffers
+    for (size_t i = 1; i < ssd.bufsize; ++i)
+        ssd.ram_buffer[i] = reference.ram_buffer[i] = random_below(256);
+
+    // Formas aleatórias dentro da tela, ligando e desligando pixels
+    for (uint32_t i = 0; i < RANDOM_SHAPES; ++i) {
+        uint8_t top = random_below(HEIGHT), left = random_below(WIDTH);
+        uint8_t height = 1 + random_below(HEIGHT - top), width = 1 + random_below(WIDTH - left);
+        bool value = random_below(2);
+        size_t op = random_below(op_count);
+
+        ops[op].draw(&ssd, top, left, width, height, value);
+        ops[op].reference(&reference, top, left, width, height, value);
+        if (memcmp(ssd.ram_buffer, reference.ram_buffer, ssd.bufsize) != 0) {
+            fprintf(stderr, "%s(%u, %u, %u, %u, %d) difere da referência\n", ops[op].name, top, left, width,
+                    height, value);
+            CHECK(false);
+            memcpy(reference.ram_buffer, ssd.ram_buffer, ssd.bufsize);
+        }
+    }
+
+    ssd1306_fill(&ssd, true);
+    reference_fill(&reference, true);
+    CHECK(memcmp(ssd.ram_buffer, reference.ram_buffer, ssd.bufsize) == 0);
+    ssd1306_fill(&ssd, false);
+    reference_fill(&reference, false);
+    CHECK(memcmp(ssd.ram_buffer, reference.ram_buffer, ssd.bufsize) == 0);
+
+    // Tempos das formas desenhadas pelo programa
+    printf("%u formas aleatórias conferidas contra a referência\n", RANDOM_SHAPES);
+    printf("tempo médio de %u chamadas, em ns do computador (não ciclos do RP2040)\n", BENCH_RUNS);
+    printf("%-22s %10s %10s\n", "operação", "pixel", "faixa");
+    printf("%-21s %10.0f %10.0f\n", "fill", bench_fill(reference_fill), bench_fill(ssd1306_fill));
+    printf("%-21s %10.0f %10.0f\n", "borda 122x58", bench(reference_rect, 3, 3, 122, 58),
+           bench(ssd1306_rect, 3, 3, 122, 58));
+    printf("%-21s %10.0f %10.0f\n", "quadrado 8x8", bench(reference_fill_rect, 28, 60, 8, 8),
+           bench(ssd1306_fill_rect, 28, 60, 8, 8));
+    printf("%-21s %10.0f %10.0f\n", "fill_rect 100x40", bench(reference_fill_rect, 11, 14, 100, 40),
+           bench(ssd1306_fill_rect, 11, 14, 100, 40));
+    printf("%-21s %10.0f %10.0f\n", "hline 128", bench(reference_hline, 30, 0, 128, 1),
+           bench(hline, 30, 0, 128, 1));
+    printf("%-21s %10.0f %10.0f\n", "vline 64", bench(reference_vline, 0, 64, 1, 64),
+           bench(vline, 0, 64, 1, 64));
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,29 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+// Verificações dos testes do computador: cada falha é impressa com arquivo e linha e
+// o teste continua; TEST_RESULT() no fim do main devolve 1 se houve falha (ctest)
+
+static int test_failures;
+
+#define CHECK(cond) do {                                                        \
+    if (!(cond)) {                                                              \
+        fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);      \
+        ++test_failures;                                                        \
+    }                                                                           \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do {                                         \
+    long long check_a = (long long) (actual), check_e = (long long) (expected); \
+    if (check_a != check_e) {                                                   \
+        fprintf(stderr, "%s:%d: falhou: %s == %lld (esperado %s = %lld)\n",     \
+                __FILE__, __LINE__, #actual, check_a, #expected, check_e);      \
+        ++test_failures;                                                        \
+    }                                                                           \
+} while (0)
+
+#define TEST_RESULT() (test_failures ? (fprintf(stderr, "%d falha(s)\n", test_failures), 1) : 0)
+
+#endif
@@ -0,0 +1,72 @@
+// Teste da calibração do joystick: uma calibração em que um eixo não foi girado até os
+// extremos é recusada (tabelas e flash ficam como estavam) e uma calibração completa
+// é aplicada, gravada na flash e recarregada por calibration_init
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hal.h"
+#include "calibration.h"
+#include "test.h"
+
+// Defines
+#define CYCLE_US 1000 // uma leitura por ciclo de controle
+
+// Declaração de variáveis
+static int16_t lut_x[CALIBRATION_LUT_SIZE], lut_y[CALIBRATION_LUT_SIZE];
+static uint8_t flash_sector[FLASH_SECTOR_SIZE];
+
+// Funções
+
+// Função que executa uma calibração: joystick solto em (2100, 1950) com ruído de
+// +-3 e depois um giro de 0 a 4095 no eixo X e, se sweep_y, também no Y
+static void calibrate(bool sweep_y) {
+    calibration_start();
+    for (uint32_t t = 0; calibration_active(); t += CYCLE_US) {
+        int16_t noise = (int16_t) (t / CYCLE_US % 7) - 3;
+        uint16_t x = 2100 + noise, y = 1950 + noise;
+
+        if (t > (CALIBRATION_CENTER_MS + 100) * 1000) {
+            uint32_t phase = t / CYCLE_US % 1000; // ida e volta entre os extremos a cada 1 s
+            uint16_t sweep = phase < 500 ? phase * 4095 / 499 : (999 - phase) * 4095 / 499;
+            x = sweep;
+            if (sweep_y)
+                y = 4095 - sweep;
+        }
+        calibration_update(x, y);
+        sleep_us(CYCLE_US);
+    }
+}
+
+int main(int argc, char **argv) {
+    const uint8_t *flash = (const uint8_t *) (XIP_BASE + CALIBRATION_FLASH_OFFSET);
+
+    calibration_init();
+    memcpy(lut_x, calibration_lut_x, sizeof(lut_x));
+    memcpy(lut_y, calibration_lut_y, sizeof(lut_y));
+    memcpy(flash_sector, flash, sizeof(flash_sector));
+
+    // Eixo Y parado no centro: curso menor que a zona morta, calibração recusada
+    calibrate(false);
+    CHECK(memcmp(lut_x, calibration_lut_x, sizeof(lut_x)) == 0);
+    CHECK(memcmp(lut_y, calibration_lut_y, sizeof(lut_y)) == 0);
+    CHECK(memcmp(flash_sector, flash, sizeof(flash_sector)) == 0);
+
+    // Giro completo nos dois eixos: centro e extremos novos
+    calibrate(true);
+    CHECK_EQ(calibration_map_x(2100), 0);
+    CHECK_EQ(calibration_map_y(1950), 0);
+    // Nos extremos, a deflexão máxima a menos da resolução da tabela (4 leituras por posição)
+    CHECK(calibration_map_x(4095) >= CALIBRATION_DEFLECTION_MAX - 4);
+    CHECK(calibration_map_x(0) <= -CALIBRATION_DEFLECTION_MAX + 4);
+    CHECK(calibration_map_y(0) <= -CALIBRATION_DEFLECTION_MAX + 4);
+    CHECK(memcmp(flash_sector, flash, sizeof(flash_sector)) != 0);
+
+    // A calibração gravada é a carregada na inicialização seguinte
+    memcpy(lut_x, calibration_lut_x, sizeof(lut_x));
+    memcpy(lut_y, calibration_lut_y, sizeof(lut_y));
+    calibration_init();
+    CHECK(memcmp(lut_x, calibration_lut_x, sizeof(lut_x)) == 0);
+    CHECK(memcmp(lut_y, calibration_lut_y, sizeof(lut_y)) == 0);
+
+    return TEST_RESULT();
+}
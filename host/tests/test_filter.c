@@ -0,0 +1,111 @@
+// Teste dos filtros de sobreamostragem (BOXCAR, CIC e IIR) com uma gravação do ADC
+// lida pela HAL (hal_adc_load_trace): um degrau em cada eixo com ruído gaussiano de
+// 4 LSB e picos de 64 LSB em 1% das amostras, como os de um cursor gasto.
+// Verifica a saída em Q12.4 depois da acomodação (média das leituras com erro
+// abaixo de meio LSB) e a redução do ruído de cada tipo de filtro
+
+#include <math.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hal.h"
+#include "filter.h"
+#include "test.h"
+
+// Defines
+#define TRACE_SAMPLES 4096   // linhas de joystick_step.txt
+#define STEP_SAMPLE 1024     // primeira amostra depois do degrau
+#define SETTLED_SAMPLE 2048  // início da janela em que a saída já se acomodou
+
+typedef struct {
+  const char *name;
+  filter_type_t type;
+  uint8_t decimation_log2, iir_shift;
+  double min_noise_reduction; // desvio das leituras / desvio das saídas
+} filter_case_t;
+
+// Declaração de variáveis
+static const filter_case_t cases[] = {
+    {"boxcar 32", FILTER_BOXCAR, 5, 0, 4.0},  // raiz(32) = 5,7
+    {"cic 3x8", FILTER_CIC, 3, 0, 3.0},       // ganho de ruído do CIC de ordem 3 e R = 8: 4,4
+    {"iir 1/16", FILTER_IIR, 3, 4, 4.0},      // raiz((2 - a) / a) com a = 1/16: 5,6
+};
+
+// Funções
+
+// Função que calcula média e desvio padrão
+static void stats(const double *values, size_t count, double *mean, double *deviation) {
+    double sum = 0, squares = 0;
+    for (size_t i = 0; i < count; ++i)
+        sum += values[i];
+    *mean = sum / count;
+    for (size_t i = 0; i < count; ++i)
+        squares += (values[i] - *mean) * (values[i] - *mean);
+    *deviation = sqrt(squares / count);
+}
+
+int main(int argc, char **argv) {
+    static double raw[TRACE_SAMPLES], outputs[TRACE_SAMPLES];
+    const char *path = argc > 1 ? argv[1] : "data/joystick_step.txt";
+
+    for (uint channel = 0; channel < 2; ++channel) {
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+            const filter_case_t *fc = &cases[c];
+            filter_t filter;
+            size_t count = 0, raw_count = 0;
+            uint16_t before_step = 0, before_window = 0; // últimas saídas antes de cada marco
+
+            // Recarregar a gravação volta a leitura ao início
+            if (!hal_adc_load_trace(path)) {
+                fprintf(stderr, "%s: gravação não encontrada\n", path);
+                return 1;
+            }
+            adc_select_input(channel);
+            filter_init(&filter, fc->type, fc->decimation_log2, fc->iir_shift);
+
+            for (size_t i = 0; i < TRACE_SAMPLES; ++i) {
+                uint16_t sample = adc_read();
+                bool ready = filter_push(&filter, sample);
+                if (i >= SETTLED_SAMPLE) {
+                    raw[raw_count++] = sample << FILTER_FRAC_BITS; // leituras em Q12.4
+                    if (ready)
+                        outputs[count++] = filter.output;
+                } else if (ready) {
+                    *(i < STEP_SAMPLE ? &before_step : &before_window) = filter.output;
+                }
+            }
+
+            double raw_mean, raw_deviation, mean, deviation;
+            stats(raw, raw_count, &raw_mean, &raw_deviation);
+            stats(outputs, count, &mean, &deviation);
+            printf("canal %u %-9s: leituras %.1f +- %.2f, saída %.1f +- %.2f (Q12.4), ruído / %.1f\n",
+                   channel, fc->name, raw_mean, raw_deviation, mean, deviation, raw_deviation / deviation);
+
+            CHECK_EQ(count, (TRACE_SAMPLES - SETTLED_SAMPLE) >> fc->decimation_log2);
+            CHECK(fabs(mean - raw_mean) < (1 << FILTER_FRAC_BITS) / 2);
+            CHECK(raw_deviation / deviation >= fc->min_noise_reduction);
+
+            // O filtro resolve frações de LSB: a saída não fica presa a múltiplos de 16
+            bool fractional = false;
+            for (size_t i = 0; i < count; ++i)
+                fractional |= ((int) outputs[i] & ((1 << FILTER_FRAC_BITS) - 1)) != 0;
+            CHECK(fractional);
+
+            // Antes do degrau a saída estava no outro nível e, ao fim da acomodação, já
+            // chegou ao novo (a menos do ruído)
+            CHECK(fabs(before_step - raw_mean) > 800 << FILTER_FRAC_BITS);
+            CHECK(fabs(before_window - raw_mean) < 4 * deviation + (1 << FILTER_FRAC_BITS));
+        }
+    }
+
+    // Filtro de bloco com passo 2 sobre pares intercalados, como no anel do ADC
+    uint16_t pairs[64];
+    filter_t boxcar;
+    for (size_t i = 0; i < 64; ++i)
+        pairs[i] = (i & 1) ? 3000 + (i & 2) : 1000; // eixo 1: 3000 e 3002 alternados
+    filter_init(&boxcar, FILTER_BOXCAR, 5, 0);
+    CHECK_EQ(filter_process(&boxcar, pairs + 1, 32, 2), 1);
+    CHECK_EQ(boxcar.output, 3001 << FILTER_FRAC_BITS);
+
+    return TEST_RESULT();
+}
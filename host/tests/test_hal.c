@@ -0,0 +1,64 @@
+// Teste da HAL simulada: tempo e temporizadores, ADC com arquivo de amostras e
+// contagem das transações I2C. Os outros testes dependem desse comportamento
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/i2c.h"
+#include "hal.h"
+#include "test.h"
+
+// Declaração de variáveis
+static int timer_calls;
+static size_t callback_bytes;
+
+// Funções
+
+static bool count_timer(repeating_timer_t *timer) {
+    return ++timer_calls < 3; // cancela a si mesmo na terceira chamada
+}
+
+static void count_i2c(const hal_i2c_transaction_t *transaction, void *context) {
+    callback_bytes += transaction->len;
+}
+
+int main(int argc, char **argv) {
+    repeating_timer_t timer;
+    uint8_t data[4] = {0x40, 1, 2, 3};
+    const char *path = "test_hal_adc.txt"; // no diretório de execução do ctest
+
+    // O relógio só avança quando pedido e dispara os temporizadores vencidos
+    uint64_t start = time_us_64();
+    add_repeating_timer_us(-1000, count_timer, NULL, &timer);
+    hal_time_advance_us(999);
+    CHECK_EQ(timer_calls, 0);
+    hal_time_advance_us(10000);
+    CHECK_EQ(timer_calls, 3);
+    CHECK_EQ(time_us_64() - start, 10999);
+
+    // O arquivo de amostras tem prioridade sobre o valor fixo e volta ao início no fim
+    FILE *file = fopen(path, "w");
+    fprintf(file, "100 200\n300 400\n");
+    fclose(file);
+    CHECK(hal_adc_load_trace(path));
+    remove(path);
+    adc_select_input(1);
+    CHECK_EQ(adc_read(), 200);
+    CHECK_EQ(adc_read(), 400);
+    CHECK_EQ(adc_read(), 200);
+    adc_select_input(0);
+    CHECK_EQ(adc_read(), 100);
+
+    // Cada transação conta o byte de endereço e leva 9 bits por byte
+    i2c_init(i2c1, 400000);
+    hal_i2c_reset_counters();
+    hal_i2c_set_callback(count_i2c, NULL);
+    start = time_us_64();
+    i2c_write_blocking(i2c1, 0x3C, data, sizeof(data), false);
+    CHECK_EQ(hal_i2c_bytes(), 5);
+    CHECK_EQ(hal_i2c_transactions(), 1);
+    CHECK_EQ(callback_bytes, 4);
+    CHECK_EQ(time_us_64() - start, 5 * 9 * 1000000 / 400000);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,229 @@
+// Teste do envio por janelas do ssd1306 (ssd1306_send_data e ssd1306_send_data_async):
+// bytes no barramento para um quadro completo, um quadro sem mudanças e movimentos de
+// um pixel do quadrado 8x8, e memória do painel igual ao ram_buffer após cada envio,
+// pelo controlador I2C e pela máquina de estado PIO; também a bomba de carga e a
+// pré-carga da configuração para cada alimentação. O painel é emulado a partir das
+// transações capturadas pela HAL
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hal.h"
+#include "ssd1306.h"
+#include "test.h"
+
+// Defines
+#define WIDTH 128
+#define HEIGHT 64
+#define PAGES (HEIGHT / 8)
+#define ADDRESS 0x3C
+#define SQUARE_SIZE 8
+
+// Emulação do controlador SSD1306: comandos de endereçamento e escrita dos pixels
+typedef struct {
+  uint8_t memory[WIDTH][PAGES];
+  uint8_t mode;                  // 0 horizontal, 1 vertical, 2 por página
+  uint8_t col, col_start, col_end;
+  uint8_t page, page_start, page_end;
+  uint8_t precharge, charge_pump;  // argumentos de 0xD9 e 0x8D (dependem da alimentação)
+  uint8_t command[8];            // comando em andamento e seus argumentos
+  uint8_t command_len, command_args;
+} panel_t;
+
+// Declaração de variáveis
+static panel_t panel;
+static ssd1306_t ssd;
+
+// Funções
+
+// Função que retorna o número de argumentos de um comando do SSD1306
+static uint8_t panel_args(uint8_t command) {
+    switch (command) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+// Função que executa um comando completo
+static void panel_execute(panel_t *p) {
+    switch (p->command[0]) {
+    case 0x20:
+        p->mode = p->command[1] & 0x03;
+        break;
+    case 0x21:
+        p->col = p->col_start = p->command[1] & 0x7F;
+        p->col_end = p->command[2] & 0x7F;
+        break;
+    case 0x22:
+        p->page = p->page_start = p->command[1] & 0x07;
+        p->page_end = p->command[2] & 0x07;
+        break;
+    case 0x8D:
+        p->charge_pump = p->command[1];
+        break;
+    case 0xD9:
+        p->precharge = p->command[1];
+        break;
+    }
+}
+
+// Função que interpreta um byte de comando (com os argumentos dos comandos anteriores)
+static void panel_command(panel_t *p, uint8_t byte) {
+    p->command[p->command_len++] = byte;
+    if (p->command_len == 1)
+        p->command_args = panel_args(byte);
+    if (p->command_len > p->command_args) {
+        panel_execute(p);
+        p->command_len = 0;
+    }
+}
+
+// Função que grava um byte de pixels e avança o ponteiro na janela atual
+static void panel_data(panel_t *p, uint8_t byte) {
+    p->memory[p->col][p->page] = byte;
+
+    if (p->mode == 1) { // vertical: desce as páginas e depois passa à próxima coluna
+        if (p->page++ == p->page_end) {
+            p->page = p->page_start;
+            p->col = p->col == p->col_end ? p->col_start : p->col + 1;
+        }
+    } else {
+        if (p->col++ == p->col_end) {
+            p->col = p->col_start;
+            if (p->mode == 0)
+                p->page = p->page == p->page_end ? p->page_start : p->page + 1;
+        }
+    }
+}
+
+// Função que recebe uma transação: byte de controle (Co e D/C) seguido dos dados
+static void panel_transaction(const hal_i2c_transaction_t *t, void *context) {
+    panel_t *p = context;
+    size_t i = 0;
+
+    if (t->address != ADDRESS)
+        return;
+    while (i < t->len) {
+        uint8_t control = t->data[i++];
+        bool single = control & 0x80; // Co = 1: só o próximo byte, depois outro controle
+        bool data = control & 0x40;
+
+        for (; i < t->len; ++i) {
+            if (data)
+                panel_data(p, t->data[i]);
+            else
+                panel_command(p, t->data[i]);
+            if (single) {
+                ++i;
+                break;
+            }
+        }
+    }
+}
+
+// Função que verifica se a memória do painel é igual ao ram_buffer
+static bool panel_matches(void) {
+    for (uint8_t x = 0; x < WIDTH; ++x) {
+        for (uint8_t page = 0; page < PAGES; ++page) {
+            if (panel.memory[x][page] != ssd.ram_buffer[x * PAGES + page + 1])
+                return false;
+        }
+    }
+    return true;
+}
+
+// Função que desenha o quadro do programa: borda e quadrado 8x8 em (x, y)
+static void draw(uint8_t x, uint8_t y) {
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect(&ssd, 3, 3, 122, 58, true);
+    ssd1306_rect(&ssd, y, x, SQUARE_SIZE, SQUARE_SIZE, true);
+}
+
+// Função que envia o quadro (síncrono ou assíncrono) e retorna os bytes no barramento,
+// conferindo que last_flush_bytes informa o mesmo valor
+static uint64_t flush(bool async) {
+    hal_i2c_reset_counters();
+    if (async) {
+        ssd1306_send_data_async(&ssd);
+        ssd1306_wait_flush(&ssd);
+    } else {
+        ssd1306_send_data(&ssd);
+    }
+    CHECK_EQ(ssd.last_flush_bytes, hal_i2c_bytes());
+    CHECK(panel_matches());
+    return hal_i2c_bytes();
+}
+
+// Função que configura o display já inicializado e confere os envios síncrono e
+// assíncrono no transporte escolhido
+static void check_flushes(void) {
+    memset(panel.memory, 0xA5, sizeof(panel.memory)); // conteúdo inicial desconhecido
+    panel.mode = 0;
+    ssd1306_config(&ssd);
+    CHECK_EQ(panel.mode, 1);
+    CHECK_EQ(panel.charge_pump, 0x14); // alimentação interna: bomba de carga ligada
+    CHECK_EQ(panel.precharge, 0xF1);
+
+    for (int async = 0; async <= 1; ++async) {
+        if (async)
+            ssd1306_dma_init(&ssd);
+        ssd1306_invalidate(&ssd);
+
+        // Quadro completo: comandos (7 + endereço) e 1024 pixels (1 + 1024 + endereço)
+        draw(60, 28);
+        CHECK_EQ(flush(async), 1034);
+
+        // Nada mudou: nada vai para o barramento
+        CHECK_EQ(flush(async), 0);
+
+        // Um pixel para a direita: some a coluna 60 e aparece a 68, páginas 3 e 4,
+        // enviadas em uma janela de 9 colunas: 8 + (1 + 9 * 2 + 1)
+        draw(61, 28);
+        CHECK_EQ(flush(async), 28);
+
+        // Um pixel para baixo: linhas 28 (página 3) e 36 (página 4) nas 8 colunas
+        draw(61, 29);
+        CHECK_EQ(flush(async), 8 + 1 + 8 * 2 + 1);
+
+        // Um pixel para cima volta ao quadro anterior
+        draw(61, 28);
+        CHECK_EQ(flush(async), 8 + 1 + 8 * 2 + 1);
+    }
+}
+
+int main(int argc, char **argv) {
+    hal_i2c_set_callback(panel_transaction, &panel);
+
+    // Controlador I2C
+    i2c_init(i2c1, 400000);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADDRESS, i2c1);
+    check_flushes();
+
+    // Máquina de estado PIO (a HAL recusa configurações que travariam a máquina)
+    uint sm = ssd1306_pio_setup(pio0, 14, 15, 1000000);
+    ssd1306_init_pio(&ssd, WIDTH, HEIGHT, false, ADDRESS, pio0, sm);
+    check_flushes();
+
+    // Alimentação externa: bomba de carga desligada e pré-carga de 2 ciclos, pelos dois
+    // transportes (ssd1306_init_pio passa por ssd1306_init)
+    ssd1306_init(&ssd, WIDTH, HEIGHT, true, ADDRESS, i2c1);
+    ssd1306_config(&ssd);
+    CHECK_EQ(panel.charge_pump, 0x10);
+    CHECK_EQ(panel.precharge, 0x22);
+    ssd1306_init_pio(&ssd, WIDTH, HEIGHT, true, ADDRESS, pio0, sm);
+    panel.charge_pump = panel.precharge = 0;
+    ssd1306_config(&ssd);
+    CHECK_EQ(panel.charge_pump, 0x10);
+    CHECK_EQ(panel.precharge, 0x22);
+
+    return TEST_RESULT();
+}
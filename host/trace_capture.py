@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Grava as entradas da placa (leituras do joystick e botões) para reprodução.
+
+Uso:
+    trace_capture.py /dev/ttyACM0 -s 5 -o entrada.trace
+
+Pede a gravação ('t'), espera os segundos indicados movendo o joystick, encerra
+('t') e pede o envio ('d'). O arquivo tem o formato descrito em include/trace.h e
+pode ser reproduzido no computador com build-host/conversorAD-replay.
+"""
+
+import argparse
+import os
+import sys
+import termios
+import time
+import tty
+
+MAGIC = b"JTRC"
+HEADER_SIZE = 12
+
+
+def read_exact(fd, size, deadline):
+    data = bytearray()
+    while len(data) < size:
+        if time.monotonic() > deadline:
+            raise TimeoutError("a placa parou de enviar a gravação")
+        data += os.read(fd, size - len(data))
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="porta serial da placa")
+    parser.add_argument("-s", "--seconds", type=float, default=5.0, help="duração da gravação (até ~8 s)")
+    parser.add_argument("-o", "--output", required=True, help="arquivo de saída")
+    args = parser.parse_args()
+
+    fd = os.open(args.port, os.O_RDWR)
+    tty.setraw(fd)
+    termios.tcflush(fd, termios.TCIFLUSH)
+
+    os.write(fd, b"t")
+    print("gravando por {:.1f} s...".format(args.seconds), file=sys.stderr)
+    time.sleep(args.seconds)
+    os.write(fd, b"t")
+    time.sleep(0.05)
+    termios.tcflush(fd, termios.TCIFLUSH)  # descarta texto ou quadros anteriores
+    os.write(fd, b"d")
+
+    # Procura o início do cabeçalho e lê o tamanho dos registros
+    deadline = time.monotonic() + 5
+    window = b""
+    while not window.endswith(MAGIC):
+        window = (window + read_exact(fd, 1, deadline))[-len(MAGIC):]
+    header = MAGIC + read_exact(fd, HEADER_SIZE - len(MAGIC), deadline)
+    length = int.from_bytes(header[8:12], "little")
+    records = read_exact(fd, length, time.monotonic() + 10)
+
+    with open(args.output, "wb") as output:
+        output.write(header + records)
+    print("{}: {} bytes de registros".format(args.output, length), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,24 @@
 #include "button.h"
 
+// Estado de debounce e de gestos de cada botão
+typedef struct {
+  uint gpio;
+  bool pressed;          // estado estável (após o debounce)
+  uint8_t count;         // amostras seguidas diferentes do estado estável
+  bool long_sent;        // toque longo já emitido neste acionamento
+  bool release_valid;    // last_release pode formar um duplo clique
+  uint32_t press_time;
+  uint32_t last_release;
+} button_state_t;
+
+// Declaração de variáveis
+static button_state_t buttons[BUTTON_MAX];
+static uint8_t button_count = 0;
+static button_event_t event_buffer[BUTTON_EVENT_QUEUE_SIZE];
+static spsc_queue_t event_queue;    // produtor: temporizador; consumidor: laço principal
+static repeating_timer_t sample_timer;
+static volatile bool sampling = false;  // temporizador de amostragem ativo
+
 // Funções
 
 // Função que inicializa o pino do botão e configura como entrada e pull up
@@ -7,4 +26,112 @@ void button_init(uint gpio) {
     gpio_init(gpio);             // inicializa o botão
     gpio_set_dir(gpio, GPIO_IN); // configura o botão como entrada
     gpio_pull_up(gpio);          // habilita o pull up interno
-}
\ No newline at end of file
+
+    // Registra o botão para a amostragem periódica
+    if (button_count < BUTTON_MAX)
+        buttons[button_count++] = (button_state_t){.gpio = gpio};
+}
+
+// Função que enfileira um evento (se a fila estiver cheia, o evento é descartado)
+static void button_emit(const button_state_t *button, button_event_type_t type, uint32_t now) {
+    button_event_t event = {.gpio = button->gpio, .type = type, .time_ms = now};
+    spsc_queue_push(&event_queue, &event);
+}
+
+// Função chamada pelo temporizador a cada BUTTON_SAMPLE_MS: debounce independente por
+// botão e detecção de pressionar, soltar, toque longo e duplo clique. O trabalho é fixo
+// por botão, o que mantém a latência da interrupção limitada
+static bool button_sample(repeating_timer_t *timer) {
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+
+    for (uint8_t i = 0; i < button_count; ++i) {
+        button_state_t *button = &buttons[i];
+        bool raw = !gpio_get(button->gpio); // botões ativos em nível baixo
+
+        if (raw == button->pressed) {
+            button->count = 0;
+        } else if (++button->count >= BUTTON_DEBOUNCE_SAMPLES) {
+            button->count = 0;
+            button->pressed = raw;
+
+            if (raw) {
+                button_emit(button, BUTTON_EVENT_PRESS, now);
+                if (button->release_valid && now - button->last_release <= BUTTON_DOUBLE_CLICK_MS) {
+                    button_emit(button, BUTTON_EVENT_DOUBLE_CLICK, now);
+                    button->release_valid = false; // um terceiro clique começa outra sequência
+                }
+                button->press_time = now;
+                button->long_sent = false;
+            } else {
+                button_emit(button, BUTTON_EVENT_RELEASE, now);
+                button->last_release = now;
+                button->release_valid = !button->long_sent;
+            }
+        }
+
+        if (button->pressed && !button->long_sent && now - button->press_time >= BUTTON_LONG_PRESS_MS) {
+            button_emit(button, BUTTON_EVENT_LONG_PRESS, now);
+            button->long_sent = true;
+        }
+    }
+    return true;
+}
+
+// Função que inicia a amostragem periódica dos botões registrados
+// (o temporizador dispara no núcleo que chamar esta função)
+void button_events_start(void) {
+    spsc_queue_init(&event_queue, event_buffer, sizeof(button_event_t), BUTTON_EVENT_QUEUE_SIZE);
+    add_repeating_timer_ms(-BUTTON_SAMPLE_MS, button_sample, NULL, &sample_timer);
+    sampling = true;
+}
+
+// Função chamada pela interrupção de borda de descida de um botão em repouso:
+// desliga as interrupções e retoma a amostragem, que faz o debounce do toque
+static void button_wake(uint gpio, uint32_t event_mask) {
+    for (uint8_t i = 0; i < button_count; ++i)
+        gpio_set_irq_enabled_with_callback(buttons[i].gpio, GPIO_IRQ_EDGE_FALL, false, button_wake);
+    if (!sampling) {
+        add_repeating_timer_ms(-BUTTON_SAMPLE_MS, button_sample, NULL, &sample_timer);
+        sampling = true;
+    }
+}
+
+// Função que suspende a amostragem periódica (para a CPU dormir mais tempo) até o
+// próximo pressionamento, detectado por interrupção de borda. Só suspende com todos
+// os botões soltos e estáveis; retorna true se suspendeu
+bool button_events_idle(void) {
+    if (!sampling)
+        return true;
+    for (uint8_t i = 0; i < button_count; ++i) {
+        if (buttons[i].pressed || buttons[i].count)
+            return false;
+    }
+
+    cancel_repeating_timer(&sample_timer);
+    sampling = false;
+    for (uint8_t i = 0; i < button_count; ++i)
+        gpio_set_irq_enabled_with_callback(buttons[i].gpio, GPIO_IRQ_EDGE_FALL, true, button_wake);
+
+    // Um toque entre a última amostra e a interrupção habilitada não gera borda
+    for (uint8_t i = 0; i < button_count; ++i) {
+        if (!gpio_get(buttons[i].gpio)) {
+            button_wake(buttons[i].gpio, GPIO_IRQ_EDGE_FALL);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Função que retira o próximo evento de botão; retorna false se não houver eventos
+bool button_get_event(button_event_t *event) {
+    return spsc_queue_pop(&event_queue, event);
+}
+
+// Função que retorna o estado estável (após o debounce) de um botão registrado
+bool button_is_pressed(uint gpio) {
+    for (uint8_t i = 0; i < button_count; ++i) {
+        if (buttons[i].gpio == gpio)
+            return buttons[i].pressed;
+    }
+    return false;
+}
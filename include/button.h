@@ -3,12 +3,36 @@
 
 #include "pico/stdio.h"
 #include "pico/stdlib.h"
+#include "spsc-queue.h"
 
 // Defines
 #define BUTTON_A_PIN 5
 #define SW 22
+#define BUTTON_MAX 4                 // botões registrados por button_init
+#define BUTTON_SAMPLE_MS 5           // período de amostragem dos botões
+#define BUTTON_DEBOUNCE_SAMPLES 4    // amostras iguais seguidas para aceitar uma mudança (20 ms)
+#define BUTTON_LONG_PRESS_MS 800     // tempo pressionado para um toque longo
+#define BUTTON_DOUBLE_CLICK_MS 300   // intervalo máximo entre soltar e pressionar de novo
+#define BUTTON_EVENT_QUEUE_SIZE 32   // eventos aguardando o laço principal (potência de 2)
+
+typedef enum {
+  BUTTON_EVENT_PRESS,
+  BUTTON_EVENT_RELEASE,
+  BUTTON_EVENT_LONG_PRESS,
+  BUTTON_EVENT_DOUBLE_CLICK
+} button_event_type_t;
+
+typedef struct {
+  uint8_t gpio;
+  uint8_t type;     // button_event_type_t
+  uint32_t time_ms; // instante da detecção
+} button_event_t;
 
 // Cabeçalhos da função
 void button_init(uint gpio);
+void button_events_start(void);
+bool button_events_idle(void);
+bool button_get_event(button_event_t *event);
+bool button_is_pressed(uint gpio);
 
-#endif
\ No newline at end of file
+#endif
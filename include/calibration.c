@@ -0,0 +1,169 @@
+#include "calibration.h"
+
+// Declaração de variáveis
+int16_t calibration_lut_x[CALIBRATION_LUT_SIZE];
+int16_t calibration_lut_y[CALIBRATION_LUT_SIZE];
+
+// Calibração padrão, derivada das zonas mortas ajustadas à mão na primeira versão
+static calibration_data_t calibration = {
+    .magic = CALIBRATION_MAGIC,
+    .x = {.min = 0, .center = 2260, .max = 4095, .dead_zone = 140},
+    .y = {.min = 0, .center = 1975, .max = 4095, .dead_zone = 125},
+};
+
+typedef enum { CALIBRATION_IDLE, CALIBRATION_CENTER, CALIBRATION_RANGE } calibration_phase_t;
+
+static calibration_phase_t phase = CALIBRATION_IDLE;
+static absolute_time_t phase_deadline;
+static uint32_t sum_x, sum_y, count;       // acumuladores do centro
+static calibration_axis_t measured_x, measured_y;
+
+// Funções
+
+// Função que calcula a soma de verificação dos dados gravados
+static uint32_t calibration_checksum(const calibration_data_t *data) {
+    const uint16_t *words = (const uint16_t *) &data->x;
+    uint32_t sum = data->magic;
+    for (size_t i = 0; i < 2 * sizeof(calibration_axis_t) / sizeof(uint16_t); ++i)
+        sum = (sum << 5) + (sum >> 27) + words[i];
+    return sum;
+}
+
+// Função que monta a tabela de um eixo: zona morta em torno do centro e escala
+// linear até cada extremo. As divisões ficam aqui, fora do laço principal
+static void calibration_build_lut(int16_t *lut, const calibration_axis_t *axis) {
+    int32_t low_span = axis->center - axis->dead_zone - axis->min;
+    int32_t high_span = axis->max - axis->center - axis->dead_zone;
+    if (low_span < 1)
+        low_span = 1;
+    if (high_span < 1)
+        high_span = 1;
+
+    for (int32_t i = 0; i < CALIBRATION_LUT_SIZE; ++i) {
+        int32_t offset = (i << CALIBRATION_LUT_SHIFT) + (1 << CALIBRATION_LUT_SHIFT) / 2 - axis->center;
+        int32_t deflection = 0;
+
+        if (offset > axis->dead_zone)
+            deflection = (offset - axis->dead_zone) * CALIBRATION_DEFLECTION_MAX / high_span;
+        else if (offset < -axis->dead_zone)
+            deflection = (offset + axis->dead_zone) * CALIBRATION_DEFLECTION_MAX / low_span;
+
+        if (deflection > CALIBRATION_DEFLECTION_MAX)
+            deflection = CALIBRATION_DEFLECTION_MAX;
+        if (deflection < -CALIBRATION_DEFLECTION_MAX)
+            deflection = -CALIBRATION_DEFLECTION_MAX;
+        lut[i] = deflection;
+    }
+}
+
+// Função que verifica se um eixo tem curso suficiente: de cada lado do centro, a faixa
+// medida deve passar de CALIBRATION_MIN_SPAN_FACTOR vezes a zona morta
+static bool calibration_axis_valid(const calibration_axis_t *axis) {
+    return axis->center - axis->min > CALIBRATION_MIN_SPAN_FACTOR * axis->dead_zone &&
+           axis->max - axis->center > CALIBRATION_MIN_SPAN_FACTOR * axis->dead_zone;
+}
+
+// Função que carrega a calibração gravada na flash (se válida) e monta as tabelas
+void calibration_init(void) {
+    const calibration_data_t *stored = (const calibration_data_t *) (XIP_BASE + CALIBRATION_FLASH_OFFSET);
+
+    if (stored->magic == CALIBRATION_MAGIC && stored->checksum == calibration_checksum(stored) &&
+        calibration_axis_valid(&stored->x) && calibration_axis_valid(&stored->y))
+        calibration = *stored;
+
+    calibration_build_lut(calibration_lut_x, &calibration.x);
+    calibration_build_lut(calibration_lut_y, &calibration.y);
+}
+
+// Função executada com o XIP e o outro núcleo parados para regravar o setor reservado
+static void calibration_flash_write(void *param) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, param, sizeof(calibration_data_t));
+
+    flash_range_erase(CALIBRATION_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(CALIBRATION_FLASH_OFFSET, page, FLASH_PAGE_SIZE);
+}
+
+// Função que inicia a calibração: primeiro o joystick deve ficar solto, depois
+// ser girado até os extremos em todas as direções
+void calibration_start(void) {
+    phase = CALIBRATION_CENTER;
+    phase_deadline = make_timeout_time_ms(CALIBRATION_CENTER_MS);
+    sum_x = sum_y = count = 0;
+    measured_x = (calibration_axis_t){.min = 4095, .max = 0};
+    measured_y = (calibration_axis_t){.min = 4095, .max = 0};
+    printf("Calibracao: solte o joystick\n");
+}
+
+// Função que informa se a calibração está em andamento
+bool calibration_active(void) {
+    return phase != CALIBRATION_IDLE;
+}
+
+// Função que registra os extremos de uma leitura
+static void calibration_track(calibration_axis_t *axis, uint16_t value) {
+    if (value < axis->min)
+        axis->min = value;
+    if (value > axis->max)
+        axis->max = value;
+}
+
+// Função que conclui a fase do centro: média das leituras e zona morta a partir do ruído
+static void calibration_finish_center(calibration_axis_t *axis, uint32_t sum) {
+    axis->center = sum / count;
+    uint16_t noise = axis->max - axis->center;
+    if (axis->center - axis->min > noise)
+        noise = axis->center - axis->min;
+    axis->dead_zone = 2 * noise + CALIBRATION_DEAD_ZONE_MARGIN;
+    axis->min = axis->max = axis->center; // reinicia os extremos para a fase seguinte
+}
+
+// Função que alimenta a calibração com uma leitura de cada eixo (chamada a cada ciclo)
+void calibration_update(uint16_t vrx_value, uint16_t vry_value) {
+    if (phase == CALIBRATION_IDLE)
+        return;
+
+    calibration_track(&measured_x, vrx_value);
+    calibration_track(&measured_y, vry_value);
+
+    if (phase == CALIBRATION_CENTER) {
+        sum_x += vrx_value;
+        sum_y += vry_value;
+        ++count;
+        if (time_reached(phase_deadline) && count > 0) {
+            calibration_finish_center(&measured_x, sum_x);
+            calibration_finish_center(&measured_y, sum_y);
+            phase = CALIBRATION_RANGE;
+            phase_deadline = make_timeout_time_ms(CALIBRATION_RANGE_MS);
+            printf("Calibracao: gire o joystick ate os extremos\n");
+        }
+        return;
+    }
+
+    if (!time_reached(phase_deadline))
+        return;
+    phase = CALIBRATION_IDLE;
+
+    // Eixo que não foi girado até os extremos (ou com ruído maior que o curso): a
+    // calibração anterior continua valendo
+    if (!calibration_axis_valid(&measured_x) || !calibration_axis_valid(&measured_y)) {
+        printf("Calibracao: curso insuficiente (x %u/%u/%u y %u/%u/%u), mantida a anterior\n",
+               measured_x.min, measured_x.center, measured_x.max,
+               measured_y.min, measured_y.center, measured_y.max);
+        return;
+    }
+
+    calibration.x = measured_x;
+    calibration.y = measured_y;
+    calibration.checksum = calibration_checksum(&calibration);
+    calibration_build_lut(calibration_lut_x, &calibration.x);
+    calibration_build_lut(calibration_lut_y, &calibration.y);
+
+    if (flash_safe_execute(calibration_flash_write, &calibration, UINT32_MAX) == PICO_OK)
+        printf("Calibracao salva: x %u/%u/%u y %u/%u/%u\n",
+               calibration.x.min, calibration.x.center, calibration.x.max,
+               calibration.y.min, calibration.y.center, calibration.y.max);
+    else
+        printf("Calibracao: falha ao gravar na flash\n");
+}
@@ -0,0 +1,51 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+// Defines
+#define CALIBRATION_MAGIC 0x43414C31u                                          // "CAL1"
+#define CALIBRATION_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)  // último setor da flash
+#define CALIBRATION_LUT_SHIFT 2                                                // índice da tabela = valor >> 2
+#define CALIBRATION_LUT_SIZE (4096 >> CALIBRATION_LUT_SHIFT)
+#define CALIBRATION_DEFLECTION_MAX 2047                                        // deflexão no fim de curso
+#define CALIBRATION_CENTER_MS 1000                                             // fase com o joystick solto
+#define CALIBRATION_RANGE_MS 5000                                              // fase girando o joystick
+#define CALIBRATION_DEAD_ZONE_MARGIN 32                                        // folga somada ao ruído medido
+#define CALIBRATION_MIN_SPAN_FACTOR 2                                          // curso mínimo de cada lado, em zonas mortas
+
+typedef struct {
+  uint16_t min, center, max; // extremos e centro medidos (0-4095)
+  uint16_t dead_zone;        // raio da zona morta em torno do centro
+} calibration_axis_t;
+
+typedef struct {
+  uint32_t magic;
+  calibration_axis_t x, y;
+  uint32_t checksum;
+} calibration_data_t;
+
+// Tabelas valor do ADC -> deflexão com sinal (-2047 a 2047, 0 dentro da zona morta)
+extern int16_t calibration_lut_x[CALIBRATION_LUT_SIZE];
+extern int16_t calibration_lut_y[CALIBRATION_LUT_SIZE];
+
+// Cabeçalhos das funções
+void calibration_init(void);
+void calibration_start(void);
+bool calibration_active(void);
+void calibration_update(uint16_t vrx_value, uint16_t vry_value);
+
+// Funções que mapeiam uma leitura de 12 bits com uma única consulta à tabela
+static inline int16_t calibration_map_x(uint16_t vrx_value) {
+    return calibration_lut_x[vrx_value >> CALIBRATION_LUT_SHIFT];
+}
+
+static inline int16_t calibration_map_y(uint16_t vry_value) {
+    return calibration_lut_y[vry_value >> CALIBRATION_LUT_SHIFT];
+}
+
+#endif
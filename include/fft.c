@@ -0,0 +1,202 @@
+#include <math.h>
+#include <stdio.h>
+#include "hardware/structs/systick.h"
+#include "fft.h"
+
+// Defines
+#define FFT_PI 3.14159265358979f
+#define FFT_QUARTER (FFT_MAX_POINTS / 4)
+#define FFT_SCALE_BIT 0x2000      // com algum |valor| >= 2^13 o próximo estágio divide a saída
+#define FFT_FULL_SCALE_BITS 12    // raia de uma senoide de fundo de escala: 2^(12 + bits)
+#define FFT_DB_PER_LOG2_Q8 7707   // 10 log10(2) décimos de dB por oitava, Q8 -> Q16
+#define FFT_FLOOR_BUCKETS (-FFT_DB_MIN / 10 + 1) // histograma do piso de ruído, 1 dB por faixa
+
+// Declaração de variáveis
+// sine[k] = sen(2 pi k / FFT_MAX_POINTS) em Q15, de 0 a 3/4 de volta: cos(x) = sine[x + 1/4]
+static int16_t sine[FFT_MAX_POINTS * 3 / 4 + 1];
+
+// Funções
+
+// Função que monta a tabela de senos (uma única vez, antes de qualquer FFT)
+void fft_init(void) {
+    for (size_t k = 0; k < sizeof(sine) / sizeof(sine[0]); ++k) {
+        float value = 32767.0f * sinf(2.0f * FFT_PI * k / FFT_MAX_POINTS);
+        sine[k] = (int16_t) (value < 0 ? value - 0.5f : value + 0.5f);
+    }
+}
+
+// Função que prepara um bloco de 2^bits leituras de 12 bits (uma a cada stride, para
+// separar um eixo do anel intercalado): retira a média, passa a Q15 e aplica a janela
+// de Hann, cujo cosseno vem da mesma tabela dos fatores de giro
+void fft_window(int16_t *re, int16_t *im, const uint16_t *samples, size_t stride, uint8_t bits) {
+    size_t n = 1u << bits, step = FFT_MAX_POINTS >> bits;
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        sum += samples[i * stride];
+    int32_t mean = (sum + (n >> 1)) >> bits;
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t k = i * step;
+        if (k > FFT_MAX_POINTS / 2)
+            k = FFT_MAX_POINTS - k; // cos(2 pi - x) = cos(x)
+        int32_t w = (32767 - sine[k + FFT_QUARTER]) >> 1;
+        re[i] = (((int32_t) samples[i * stride] - mean) * 8 * w) >> 15;
+        im[i] = 0;
+    }
+}
+
+// Função que retorna um valor com os mesmos bits altos do maior |re| ou |im|
+static uint32_t fft_peak(const int16_t *re, const int16_t *im, size_t n) {
+    uint32_t peak = 0;
+    for (size_t i = 0; i < n; ++i)
+        peak |= (uint32_t) ((re[i] ^ (re[i] >> 15)) | (im[i] ^ (im[i] >> 15)));
+    return peak;
+}
+
+// Função que calcula a FFT de 2^bits pontos no próprio vetor (dizimação no tempo).
+// Só usa multiplicações de 16x16 bits (MULS de um ciclo no M0+), pula as do fator de
+// giro unitário e retorna o expoente de bloco: a saída verdadeira é a calculada vezes
+// 2^expoente
+uint8_t fft_run(int16_t *re, int16_t *im, uint8_t bits) {
+    size_t n = 1u << bits;
+    uint8_t exponent = 0;
+
+    // Permutação por inversão de bits (contador invertido incremental, sem tabela)
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+        if (i < j) {
+            int16_t t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    uint32_t peak = fft_peak(re, im, n);
+    for (size_t half = 1, step = FFT_MAX_POINTS / 2; half < n; half <<= 1, step >>= 1) {
+        // Com entradas abaixo de 2^13, a + w b (|w b| <= raiz(2) 2^13) cabe em 16 bits;
+        // abaixo de 2^14 basta dividir por 2, acima divide por 4
+        uint8_t shift = (peak >= FFT_SCALE_BIT) + (peak >= 2 * FFT_SCALE_BIT);
+        exponent += shift;
+        peak = 0;
+
+        // Fator de giro 1: só somas
+        for (size_t i = 0; i < n; i += 2 * half) {
+            size_t j = i + half;
+            int32_t ar = re[i], ai = im[i], br = re[j], bi = im[j];
+            re[i] = (ar + br) >> shift;
+            im[i] = (ai + bi) >> shift;
+            re[j] = (ar - br) >> shift;
+            im[j] = (ai - bi) >> shift;
+            peak |= (uint32_t) ((re[i] ^ (re[i] >> 15)) | (im[i] ^ (im[i] >> 15)) |
+                                (re[j] ^ (re[j] >> 15)) | (im[j] ^ (im[j] >> 15)));
+        }
+
+        for (size_t k = 1; k < half; ++k) {
+            int32_t wr = sine[k * step + FFT_QUARTER], wi = -sine[k * step];
+            for (size_t i = k; i < n; i += 2 * half) {
+                size_t j = i + half;
+                int32_t tr = (wr * re[j] - wi * im[j]) >> 15;
+                int32_t ti = (wr * im[j] + wi * re[j]) >> 15;
+                int32_t ar = re[i], ai = im[i];
+                re[i] = (ar + tr) >> shift;
+                im[i] = (ai + ti) >> shift;
+                re[j] = (ar - tr) >> shift;
+                im[j] = (ai - ti) >> shift;
+                peak |= (uint32_t) ((re[i] ^ (re[i] >> 15)) | (im[i] ^ (im[i] >> 15)) |
+                                    (re[j] ^ (re[j] >> 15)) | (im[j] ^ (im[j] >> 15)));
+            }
+        }
+    }
+    return exponent;
+}
+
+// Função que converte uma potência (|X|^2 calculado) em décimos de dBFS: log2 pela
+// posição do bit mais alto e uma correção parabólica da fração (erro < 0,05 dB)
+static int16_t fft_db(uint32_t power, int32_t offset_q8) {
+    if (power == 0)
+        return FFT_DB_MIN;
+
+    uint8_t n = 31 - __builtin_clz(power);
+    uint32_t f = (power << (31 - n) >> 23) & 0xFF; // 8 bits após o bit mais alto
+    int32_t log2_q8 = (n << 8) + f + ((f * (256 - f) * 89) >> 16);
+    int32_t db = ((log2_q8 + offset_q8) * FFT_DB_PER_LOG2_Q8) >> 16;
+    return db < FFT_DB_MIN ? FFT_DB_MIN : db;
+}
+
+// Função que calcula o espectro de potência das raias 0 a 2^(bits-1) - 1 em décimos
+// de dBFS (0 = senoide de fundo de escala, com o ganho 1/2 da janela de Hann).
+// db pode ser o próprio re: cada raia só lê a sua posição antes de escrevê-la
+void fft_spectrum_db(const int16_t *re, const int16_t *im, uint8_t bits, uint8_t exponent, int16_t *db) {
+    int32_t offset_q8 = 512 * ((int32_t) exponent - FFT_FULL_SCALE_BITS - bits);
+
+    for (size_t k = 0; k < (1u << bits) / 2; ++k) {
+        uint32_t power = (uint32_t) (re[k] * re[k]) + (uint32_t) (im[k] * im[k]);
+        db[k] = fft_db(power, offset_q8);
+    }
+}
+
+// Função que estima o piso de ruído (décimos de dBFS) como a mediana das raias, que
+// ignora os picos; usa um histograma de 1 dB em vez de ordenar as raias
+int16_t fft_noise_floor(const int16_t *db, size_t bins) {
+    uint16_t histogram[FFT_FLOOR_BUCKETS] = {0};
+
+    for (size_t k = 0; k < bins; ++k) {
+        int32_t bucket = (db[k] - FFT_DB_MIN) / 10;
+        ++histogram[bucket < FFT_FLOOR_BUCKETS ? bucket : FFT_FLOOR_BUCKETS - 1];
+    }
+
+    size_t count = 0;
+    for (int32_t bucket = 0; bucket < FFT_FLOOR_BUCKETS; ++bucket) {
+        count += histogram[bucket];
+        if (2 * count >= bins)
+            return FFT_DB_MIN + bucket * 10 + 5;
+    }
+    return 0;
+}
+
+// Função que mede, com o SysTick (ciclos do núcleo), a FFT e o espectro em dB de cada
+// tamanho de FFT_MIN_BITS a FFT_MAX_BITS e imprime uma linha por tamanho. re e im
+// precisam de FFT_MAX_POINTS posições; o conteúdo é descartado
+void fft_benchmark(int16_t *re, int16_t *im) {
+    uint32_t seed = 1;
+
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+
+    for (uint8_t bits = FFT_MIN_BITS; bits <= FFT_MAX_BITS; ++bits) {
+        size_t n = 1u << bits;
+        uint32_t fft_cycles = 0, db_cycles = 0;
+
+        for (uint8_t run = 0; run < FFT_BENCHMARK_RUNS; ++run) {
+            // Ruído pseudoaleatório com a amplitude de leituras de 12 bits em Q15
+            for (size_t i = 0; i < n; ++i) {
+                seed = seed * 1664525 + 1013904223;
+                re[i] = (int16_t) (seed >> 16) >> 2;
+                im[i] = 0;
+            }
+
+            uint32_t start = systick_hw->cvr;
+            uint8_t exponent = fft_run(re, im, bits);
+            uint32_t middle = systick_hw->cvr;
+            fft_spectrum_db(re, im, bits, exponent, re);
+            uint32_t end = systick_hw->cvr;
+
+            fft_cycles += (start - middle) & 0x00FFFFFF; // o SysTick conta para baixo
+            db_cycles += (middle - end) & 0x00FFFFFF;
+        }
+
+        fft_cycles /= FFT_BENCHMARK_RUNS;
+        db_cycles /= FFT_BENCHMARK_RUNS;
+        printf("fft %4u pontos: %7lu ciclos (%lu por borboleta), espectro em dB %6lu ciclos\n",
+               (unsigned) n, (unsigned long) fft_cycles, (unsigned long) (fft_cycles / (n / 2 * bits)),
+               (unsigned long) db_cycles);
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include "pico/stdlib.h"
+
+// Defines
+// FFT radix-2 em ponto fixo (Q15, sem ponto flutuante) para o Cortex-M0+. Os dados
+// ficam em int16 com expoente de bloco: um estágio só divide por 2 quando algum
+// valor pode transbordar, o que preserva a resolução de sinais fracos
+#define FFT_MIN_BITS 4
+#define FFT_MAX_BITS 10
+#define FFT_MAX_POINTS (1u << FFT_MAX_BITS)
+#define FFT_DB_MIN (-1600)   // décimos de dBFS informados para uma raia nula
+#define FFT_BENCHMARK_RUNS 8 // repetições por tamanho em fft_benchmark
+
+// Cabeçalhos das funções
+void fft_init(void);
+void fft_window(int16_t *re, int16_t *im, const uint16_t *samples, size_t stride, uint8_t bits);
+uint8_t fft_run(int16_t *re, int16_t *im, uint8_t bits);
+void fft_spectrum_db(const int16_t *re, const int16_t *im, uint8_t bits, uint8_t exponent, int16_t *db);
+int16_t fft_noise_floor(const int16_t *db, size_t bins);
+void fft_benchmark(int16_t *re, int16_t *im);
+
+#endif
@@ -0,0 +1,87 @@
+#include "filter.h"
+
+// Funções
+
+// Função que ajusta um valor com bits extras de ganho para o formato de saída Q12.4
+static inline uint16_t filter_normalize(uint32_t value, uint8_t gain_bits) {
+    if (gain_bits >= FILTER_FRAC_BITS)
+        return value >> (gain_bits - FILTER_FRAC_BITS);
+    return value << (FILTER_FRAC_BITS - gain_bits);
+}
+
+// Função que inicializa um filtro de sobreamostragem e decimação
+// Todos os filtros trabalham só com inteiros (sem ponto flutuante no Cortex-M0+)
+// e entregam a saída em Q12.4, ganhando resolução com a média de várias amostras
+void filter_init(filter_t *filter, filter_type_t type, uint8_t decimation_log2, uint8_t iir_shift) {
+    uint8_t max_decimation = (type == FILTER_CIC) ? FILTER_CIC_MAX_DECIMATION : FILTER_MAX_DECIMATION;
+
+    filter->type = type;
+    filter->decimation_log2 = decimation_log2 > max_decimation ? max_decimation : decimation_log2;
+    filter->iir_shift = iir_shift > 15 ? 15 : iir_shift;
+    filter->count = 0;
+    filter->acc = 0;
+    for (uint8_t i = 0; i < FILTER_CIC_STAGES; ++i) {
+        filter->integrators[i] = 0;
+        filter->combs[i] = 0;
+    }
+    filter->iir_state = -1; // marca o IIR como não inicializado
+    filter->output = 0;
+}
+
+// Função que insere uma amostra de 12 bits no filtro
+// Retorna true quando uma nova saída decimada está disponível em filter->output
+bool filter_push(filter_t *filter, uint16_t sample) {
+    bool ready = ++filter->count >= (1u << filter->decimation_log2);
+
+    switch (filter->type) {
+    case FILTER_BOXCAR:
+        filter->acc += sample;
+        if (ready) {
+            filter->output = filter_normalize(filter->acc, filter->decimation_log2);
+            filter->acc = 0;
+        }
+        break;
+
+    case FILTER_CIC: {
+        // Integradores a cada amostra; o estouro modular se cancela nos pentes
+        uint32_t value = sample;
+        for (uint8_t i = 0; i < FILTER_CIC_STAGES; ++i) {
+            filter->integrators[i] += value;
+            value = filter->integrators[i];
+        }
+        if (ready) {
+            // Pentes na taxa decimada; ganho total de 2^(k * estágios)
+            for (uint8_t i = 0; i < FILTER_CIC_STAGES; ++i) {
+                uint32_t delayed = filter->combs[i];
+                filter->combs[i] = value;
+                value -= delayed;
+            }
+            filter->output = filter_normalize(value, filter->decimation_log2 * FILTER_CIC_STAGES);
+        }
+        break;
+    }
+
+    case FILTER_IIR: {
+        int32_t target = (int32_t) sample << 16;
+        if (filter->iir_state < 0)
+            filter->iir_state = target; // parte do primeiro valor, sem transitório
+        filter->iir_state += (target - filter->iir_state) >> filter->iir_shift;
+        if (ready)
+            filter->output = filter->iir_state >> (16 - FILTER_FRAC_BITS);
+        break;
+    }
+    }
+
+    if (ready)
+        filter->count = 0;
+    return ready;
+}
+
+// Função que filtra um bloco de amostras com passo stride (2 para um eixo do anel intercalado)
+// Retorna o número de saídas produzidas; a última fica em filter->output
+size_t filter_process(filter_t *filter, const uint16_t *samples, size_t count, size_t stride) {
+    size_t outputs = 0;
+    for (size_t i = 0; i < count; ++i)
+        outputs += filter_push(filter, samples[i * stride]);
+    return outputs;
+}
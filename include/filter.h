@@ -0,0 +1,35 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "pico/stdlib.h"
+
+// Defines
+#define FILTER_FRAC_BITS 4          // bits fracionários da saída (saída = valor do ADC * 16)
+#define FILTER_CIC_STAGES 3         // número de estágios integrador/pente do CIC
+#define FILTER_CIC_MAX_DECIMATION 6 // log2 máximo da decimação do CIC (12 + 3 * 6 bits cabem em 32)
+#define FILTER_MAX_DECIMATION 16    // log2 máximo da decimação do boxcar e do IIR
+
+typedef enum {
+  FILTER_BOXCAR, // média de 2^k amostras
+  FILTER_CIC,    // integrador-pente de 3 estágios com decimação 2^k
+  FILTER_IIR     // passa-baixas de um polo, alfa = 2^-shift, amostrado a cada 2^k entradas
+} filter_type_t;
+
+typedef struct {
+  filter_type_t type;
+  uint8_t decimation_log2;                   // k: uma saída a cada 2^k amostras
+  uint8_t iir_shift;                         // constante de tempo do IIR
+  uint32_t count;                            // amostras do ciclo de decimação atual
+  uint32_t acc;                              // soma do boxcar
+  uint32_t integrators[FILTER_CIC_STAGES];   // integradores do CIC (aritmética modular)
+  uint32_t combs[FILTER_CIC_STAGES];         // atrasos dos pentes do CIC
+  int32_t iir_state;                         // estado do IIR em Q12.16
+  uint16_t output;                           // última saída em Q12.4
+} filter_t;
+
+// Cabeçalhos das funções
+void filter_init(filter_t *filter, filter_type_t type, uint8_t decimation_log2, uint8_t iir_shift);
+bool filter_push(filter_t *filter, uint16_t sample);
+size_t filter_process(filter_t *filter, const uint16_t *samples, size_t count, size_t stride);
+
+#endif
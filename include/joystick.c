@@ -1,5 +1,12 @@
 #include "joystick.h"
 
+// Declaração de variáveis
+static uint16_t ring[JOYSTICK_RING_SAMPLES] __attribute__((aligned(JOYSTICK_RING_SAMPLES * sizeof(uint16_t))));
+static uint32_t ring_transfers = JOYSTICK_RING_SAMPLES; // recarga do contador do canal de dados
+static int data_channel = -1, control_channel = -1;    // canais DMA da aquisição contínua
+static uint32_t stream_rate = 0;                       // taxa efetiva da aquisição contínua (S/s)
+static bool streaming = false;
+
 // Funções
 
 // Função para configurar o joystick (pinos de leitura e ADC)
@@ -11,6 +18,14 @@ void setup_joystick() {
 
 // Função para ler os valores dos eixos do joystick (X e Y)
 void joystick_read_axis(uint16_t *vrx_value, uint16_t *vry_value) {
+    // Com a aquisição contínua ativa, usa o par mais recente do anel
+    if (streaming) {
+        const uint16_t *block = joystick_stream_latest();
+        *vry_value = block[JOYSTICK_BLOCK_SAMPLES - 2];
+        *vrx_value = block[JOYSTICK_BLOCK_SAMPLES - 1];
+        return;
+    }
+
     // Leitura do valor do eixo Y do joystick
     adc_select_input(ADC_CHANNEL_0); // seleciona o canal ADC para o eixo Y
     sleep_us(2);                     // pequeno delay para estabilidade
@@ -20,4 +35,103 @@ void joystick_read_axis(uint16_t *vrx_value, uint16_t *vry_value) {
     adc_select_input(ADC_CHANNEL_1); // seleciona o canal ADC para o eixo X
     sleep_us(2);                     // pequeno delay para estabilidade
     *vrx_value = adc_read();         // lê o valor do eixo X (0-4095)
-}
\ No newline at end of file
+}
+
+// Função que inicia a aquisição contínua dos dois eixos
+// O ADC alterna entre os canais 0 e 1 (round robin) na taxa pedida (soma dos canais)
+// e o DMA copia a FIFO do ADC para o anel. Um segundo canal DMA recarrega o contador
+// do primeiro ao fim de cada volta, de modo que a aquisição nunca para.
+void joystick_stream_start(uint32_t sample_rate) {
+    if (streaming)
+        joystick_stream_stop();
+    if (sample_rate > JOYSTICK_MAX_SAMPLE_RATE)
+        sample_rate = JOYSTICK_MAX_SAMPLE_RATE;
+    if (sample_rate == 0)
+        sample_rate = 1;
+
+    adc_select_input(ADC_CHANNEL_0); // a sequência começa pelo eixo Y
+    adc_set_round_robin((1u << ADC_CHANNEL_0) | (1u << ADC_CHANNEL_1));
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(48000000.0f / sample_rate - 1.0f); // período = (1 + div) ciclos de 48 MHz
+    stream_rate = sample_rate;
+    adc_fifo_drain();
+
+    if (data_channel < 0) {
+        data_channel = dma_claim_unused_channel(true);
+        control_channel = dma_claim_unused_channel(true);
+    }
+
+    // Canal de dados: FIFO do ADC -> anel, reiniciado pelo canal de controle
+    dma_channel_config data_config = dma_channel_get_default_config(data_channel);
+    channel_config_set_transfer_data_size(&data_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&data_config, false);
+    channel_config_set_write_increment(&data_config, true);
+    channel_config_set_ring(&data_config, true, JOYSTICK_RING_BITS);
+    channel_config_set_dreq(&data_config, DREQ_ADC);
+    channel_config_set_chain_to(&data_config, control_channel);
+    dma_channel_configure(data_channel, &data_config, ring, &adc_hw->fifo, JOYSTICK_RING_SAMPLES, false);
+
+    // Canal de controle: escreve a contagem no registrador de disparo do canal de dados
+    dma_channel_config control_config = dma_channel_get_default_config(control_channel);
+    channel_config_set_transfer_data_size(&control_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&control_config, false);
+    channel_config_set_write_increment(&control_config, false);
+    dma_channel_configure(
+        control_channel,
+        &control_config,
+        &dma_hw->ch[data_channel].al1_transfer_count_trig,
+        &ring_transfers,
+        1,
+        false);
+
+    dma_channel_start(data_channel);
+    adc_run(true);
+    streaming = true;
+}
+
+// Função que encerra a aquisição contínua e devolve o ADC ao modo de leitura única
+void joystick_stream_stop(void) {
+    if (!streaming)
+        return;
+
+    adc_run(false);
+    dma_channel_abort(control_channel);
+    dma_channel_abort(data_channel);
+    dma_channel_abort(control_channel); // o aborto do canal de dados pode disparar o encadeamento
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    adc_set_round_robin(0);
+    streaming = false;
+}
+
+// Função que informa se a aquisição contínua está ativa
+bool joystick_streaming(void) {
+    return streaming;
+}
+
+// Função que retorna o bloco completo mais recente do anel, sem cópia
+// O bloco tem JOYSTICK_BLOCK_SAMPLES amostras intercaladas [Y, X, ...] e permanece
+// válido até o DMA dar a volta no anel (JOYSTICK_RING_SAMPLES - 2 * JOYSTICK_BLOCK_SAMPLES
+// amostras depois, cerca de 1,8 ms a 500 kS/s)
+const uint16_t *joystick_stream_latest(void) {
+    uint32_t write = joystick_stream_position();
+    uint32_t current = write & ~(JOYSTICK_BLOCK_SAMPLES - 1); // bloco sendo escrito agora
+    uint32_t latest = (current - JOYSTICK_BLOCK_SAMPLES) & (JOYSTICK_RING_SAMPLES - 1);
+    return &ring[latest];
+}
+
+// Função que retorna o índice, no anel, da próxima amostra que o DMA vai escrever
+uint32_t joystick_stream_position(void) {
+    return (dma_hw->ch[data_channel].write_addr - (uintptr_t) ring) / sizeof(uint16_t);
+}
+
+// Função que retorna o anel da aquisição contínua (JOYSTICK_RING_SAMPLES amostras
+// intercaladas [Y, X, ...]) para quem precisa consumir todos os blocos, sem cópia
+const uint16_t *joystick_stream_ring(void) {
+    return ring;
+}
+
+// Função que retorna a taxa da aquisição contínua (soma dos canais, em amostras/s)
+uint32_t joystick_stream_rate(void) {
+    return stream_rate;
+}
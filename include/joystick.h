@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
+#include "hardware/dma.h"
 
 // Defines
 #define VRX 27        
@@ -11,8 +12,21 @@
 #define ADC_CHANNEL_0 0
 #define ADC_CHANNEL_1 1
 
+// Aquisição contínua: o anel guarda as amostras intercaladas [Y, X, Y, X, ...]
+#define JOYSTICK_RING_BITS 11                                        // anel de 2 KB (alinhado ao próprio tamanho)
+#define JOYSTICK_RING_SAMPLES (1u << (JOYSTICK_RING_BITS - 1))       // amostras de 16 bits no anel
+#define JOYSTICK_BLOCK_SAMPLES 64                                    // amostras por bloco (32 pares Y/X)
+#define JOYSTICK_MAX_SAMPLE_RATE 500000                              // taxa máxima do ADC (soma dos canais)
+
 // Cabeçalhos das funções
 void joystick_read_axis(uint16_t *vrx_value, uint16_t *vry_value);
 void setup_joystick();
+void joystick_stream_start(uint32_t sample_rate);
+void joystick_stream_stop(void);
+bool joystick_streaming(void);
+const uint16_t *joystick_stream_latest(void);
+uint32_t joystick_stream_position(void);
+const uint16_t *joystick_stream_ring(void);
+uint32_t joystick_stream_rate(void);
 
-#endif
\ No newline at end of file
+#endif
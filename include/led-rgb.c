@@ -1,8 +1,57 @@
+#include <stdlib.h>
 #include "led-rgb.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+
+// Estado de um slice de PWM: os dois canais compartilham o registrador CC
+// (canal A nos 16 bits baixos, B nos altos), então a transição é feita por slice
+typedef struct {
+  int dma_channel;   // canal que copia a rampa para o CC
+  int dma_timer;     // temporizador que dá o ritmo dos degraus
+  uint32_t target;   // valor final de CC dos dois canais
+  uint32_t *ramp;    // valores de CC de cada degrau; NULL enquanto o slice não tiver LEDs configurados
+} led_slice_t;
 
 // Declaração de variáveis
-const float PWM_DIVISOR = 4.0;
-const uint16_t WRAP_PERIOD = 4095;   
+static uint16_t wrap_period;
+static float pwm_divisor;
+static led_slice_t slices[NUM_PWM_SLICES];
+
+// Curva de gama 2.2 em 16 bits para cada brilho de 0 a 255 (escalada para o wrap em uso)
+static const uint16_t led_gamma[256] = {
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535,
+};
 
 // Funções
 
@@ -12,12 +61,102 @@ void led_init(uint gpio) {
     gpio_set_dir(gpio, GPIO_OUT); // configura o LED como saída
 }
 
-// Função para configurar o PWM de um LED
-void pwm_led_setup(uint led, uint *slice, uint16_t level, bool state_led) {
-    gpio_set_function(led, GPIO_FUNC_PWM); // configura o pino do LED como saída PWM
-    *slice = pwm_gpio_to_slice_num(led);   // obtém o slice do PWM associado ao pino do LED
-    pwm_set_clkdiv(*slice, PWM_DIVISOR);   // define o divisor de clock do PWM
-    pwm_set_wrap(*slice, WRAP_PERIOD);     // configura o valor máximo do contador (período do PWM)
-    pwm_set_gpio_level(led, 0);            // define o level do slice e do canal
-    pwm_set_enabled(*slice, true);         // habilita o PWM no slice correspondente ao LED
-}
\ No newline at end of file
+// Função que define a resolução (bits) e a frequência do PWM dos LEDs configurados a seguir
+void led_pwm_init(uint8_t bits, uint32_t frequency_hz) {
+    wrap_period = (1u << bits) - 1;
+    pwm_divisor = (float) clock_get_hz(clk_sys) / ((float) frequency_hz * (wrap_period + 1));
+    if (pwm_divisor < 1.0f)
+        pwm_divisor = 1.0f;   // frequência limitada pelo clock do sistema
+    else if (pwm_divisor > 255.9375f)
+        pwm_divisor = 255.9375f;
+}
+
+// Função para configurar o PWM de um LED, apagado, com transições por DMA
+void led_pwm_setup(uint gpio) {
+    uint slice_num = pwm_gpio_to_slice_num(gpio);
+    led_slice_t *slice = &slices[slice_num];
+
+    if (wrap_period == 0)
+        led_pwm_init(LED_PWM_BITS, LED_PWM_FREQUENCY);
+
+    gpio_set_function(gpio, GPIO_FUNC_PWM); // configura o pino do LED como saída PWM
+    pwm_set_gpio_level(gpio, 0);            // começa apagado
+    if (slice->ramp)
+        return; // o outro canal do slice já configurou o restante
+
+    pwm_set_clkdiv(slice_num, pwm_divisor); // define o divisor de clock do PWM
+    pwm_set_wrap(slice_num, wrap_period);   // configura o valor máximo do contador (período do PWM)
+    pwm_set_enabled(slice_num, true);       // habilita o PWM no slice correspondente ao LED
+
+    // Um canal DMA por slice copia a rampa para o CC no ritmo de um temporizador de DMA;
+    // o CC só é aplicado pelo PWM no fim de cada período, sem degraus parciais
+    slice->ramp = calloc(LED_FADE_STEPS, sizeof(uint32_t));
+    slice->target = 0;
+    slice->dma_channel = dma_claim_unused_channel(true);
+    slice->dma_timer = dma_claim_unused_timer(true);
+
+    dma_channel_config config = dma_channel_get_default_config(slice->dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, dma_get_timer_dreq(slice->dma_timer));
+    dma_channel_configure(slice->dma_channel, &config, &pwm_hw->slice[slice_num].cc, slice->ramp, 0, false);
+}
+
+// Função que converte um brilho perceptual (0-255) no nível de PWM corrigido por gama
+uint16_t led_gamma_level(uint8_t brightness) {
+    return ((uint32_t) led_gamma[brightness] * (wrap_period + 1)) >> 16;
+}
+
+// Função que aplica um brilho imediatamente; o outro LED do slice, se estiver em
+// transição, vai direto ao seu brilho final
+void led_set_brightness(uint gpio, uint8_t brightness) {
+    led_fade_to(gpio, brightness, 0);
+}
+
+// Função que inicia uma transição suave do brilho atual até o novo brilho. A rampa é
+// calculada uma vez e o DMA a copia para o PWM, sem trabalho da CPU por degrau.
+// Com o clock padrão de 125 MHz a duração máxima é de cerca de 130 ms
+void led_fade_to(uint gpio, uint8_t brightness, uint32_t duration_ms) {
+    uint slice_num = pwm_gpio_to_slice_num(gpio);
+    led_slice_t *slice = &slices[slice_num];
+    uint shift = pwm_gpio_to_channel(gpio) ? 16 : 0;
+
+    if (!slice->ramp)
+        return; // slice sem led_pwm_setup: canal e temporizador de DMA não foram reservados
+
+    slice->target = (slice->target & ~(0xFFFFu << shift)) | ((uint32_t) led_gamma_level(brightness) << shift);
+
+    // Uma transição em andamento para onde está e a nova parte do nível atual,
+    // inclusive no outro canal do slice
+    dma_channel_abort(slice->dma_channel);
+    uint32_t start = pwm_hw->slice[slice_num].cc;
+    if (duration_ms == 0 || start == slice->target) {
+        pwm_hw->slice[slice_num].cc = slice->target;
+        return;
+    }
+
+    int32_t start_a = start & 0xFFFF, start_b = start >> 16;
+    int32_t delta_a = (int32_t) (slice->target & 0xFFFF) - start_a;
+    int32_t delta_b = (int32_t) (slice->target >> 16) - start_b;
+    for (int32_t i = 1; i <= LED_FADE_STEPS; ++i) {
+        uint32_t a = start_a + delta_a * i / LED_FADE_STEPS;
+        uint32_t b = start_b + delta_b * i / LED_FADE_STEPS;
+        slice->ramp[i - 1] = a | (b << 16);
+    }
+
+    // Ritmo de 1/Y do clock do sistema, com Y limitado a 16 bits
+    uint32_t y = (uint32_t) ((uint64_t) clock_get_hz(clk_sys) * duration_ms / (1000u * LED_FADE_STEPS));
+    if (y == 0)
+        y = 1;
+    else if (y > 0xFFFF)
+        y = 0xFFFF;
+    dma_timer_set_fraction(slice->dma_timer, 1, y);
+    dma_channel_transfer_from_buffer_now(slice->dma_channel, slice->ramp, LED_FADE_STEPS);
+}
+
+// Função que informa se o slice do LED ainda está em transição
+bool led_fading(uint gpio) {
+    led_slice_t *slice = &slices[pwm_gpio_to_slice_num(gpio)];
+    return slice->ramp && dma_channel_is_busy(slice->dma_channel);
+}
@@ -9,9 +9,17 @@
 #define GREEN_LED_PIN 11
 #define BLUE_LED_PIN 12
 #define RED_LED_PIN 13
+#define LED_PWM_BITS 12          // resolução padrão do PWM dos LEDs (wrap = 2^bits - 1)
+#define LED_PWM_FREQUENCY 10000  // frequência padrão do PWM dos LEDs (Hz)
+#define LED_FADE_STEPS 256       // degraus de uma transição, cada um um valor do registrador CC
 
 // Cabeçalhos das funções
 void led_init(uint gpio);
-void pwm_led_setup(uint led, uint *slice, uint16_t level, bool state_led);
+void led_pwm_init(uint8_t bits, uint32_t frequency_hz);
+void led_pwm_setup(uint gpio);
+uint16_t led_gamma_level(uint8_t brightness);
+void led_set_brightness(uint gpio, uint8_t brightness);
+void led_fade_to(uint gpio, uint8_t brightness, uint32_t duration_ms);
+bool led_fading(uint gpio);
 
-#endif // LED_RGB_H
\ No newline at end of file
+#endif // LED_RGB_H
@@ -0,0 +1,95 @@
+#include "motion.h"
+
+// Declaração de variáveis
+static int32_t speed_curve[1 << MOTION_CURVE_BITS]; // velocidade alvo por faixa de |deflexão|
+static bool curve_ready = false;
+
+// Funções
+
+// Função que monta a curva de aceleração: velocidade quadrática na deflexão, para
+// precisão perto do centro e rapidez nos extremos (as divisões ficam só aqui)
+static void motion_build_curve(void) {
+    const int32_t last = (1 << MOTION_CURVE_BITS) - 1;
+
+    for (int32_t i = 0; i <= last; ++i)
+        speed_curve[i] = (int32_t) ((int64_t) MOTION_MAX_SPEED * i * i / (last * last));
+    curve_ready = true;
+}
+
+// Função que converte a deflexão de um eixo na velocidade alvo, com sinal
+static inline int32_t motion_target_speed(int16_t deflection) {
+    int32_t index = (deflection < 0 ? -deflection : deflection) >> (MOTION_DEFLECTION_BITS - MOTION_CURVE_BITS);
+    return deflection < 0 ? -speed_curve[index] : speed_curve[index];
+}
+
+// Função que aproxima a velocidade do alvo (aceleração proporcional à diferença); quando
+// o passo fica abaixo da resolução, chega direto ao alvo para não deixar resíduo
+static inline int32_t motion_approach(int32_t velocity, int32_t target) {
+    int32_t step = (target - velocity) >> MOTION_ACCEL_SHIFT;
+    return step ? velocity + step : target;
+}
+
+// Função que mantém um eixo dentro dos limites; ao colidir com a borda, a velocidade
+// inverte e perde metade da intensidade
+static inline void motion_collide(int32_t *position, int32_t *velocity, int32_t min, int32_t max) {
+    if (*position < min) {
+        *position = min;
+        *velocity = -*velocity >> 1;
+    } else if (*position > max) {
+        *position = max;
+        *velocity = -*velocity >> 1;
+    }
+}
+
+// Função que inicializa o modelo no modo absoluto, parado no centro da área
+// [min_x, max_x] x [min_y, max_y] (limites do canto superior esquerdo, em pixels)
+void motion_init(motion_t *motion, int min_x, int min_y, int max_x, int max_y) {
+    if (!curve_ready)
+        motion_build_curve();
+
+    motion->mode = MOTION_ABSOLUTE;
+    motion->min_x = min_x << MOTION_FRAC_BITS;
+    motion->max_x = max_x << MOTION_FRAC_BITS;
+    motion->min_y = min_y << MOTION_FRAC_BITS;
+    motion->max_y = max_y << MOTION_FRAC_BITS;
+    motion->center_x = (motion->min_x + motion->max_x) >> 1;
+    motion->center_y = (motion->min_y + motion->max_y) >> 1;
+    motion->half_x = (max_x - min_x) >> 1;
+    motion->half_y = (max_y - min_y) >> 1;
+    motion->x = motion->center_x;
+    motion->y = motion->center_y;
+    motion->vx = 0;
+    motion->vy = 0;
+}
+
+// Função que troca o modo; o objeto continua de onde está, parado
+void motion_set_mode(motion_t *motion, motion_mode_t mode) {
+    motion->mode = mode;
+    motion->vx = 0;
+    motion->vy = 0;
+}
+
+// Função que avança o modelo um passo de tempo fixo com a deflexão calibrada atual.
+// O eixo Y do joystick é invertido em relação à tela
+void motion_step(motion_t *motion, int16_t x_deflection, int16_t y_deflection) {
+    if (motion->mode == MOTION_ABSOLUTE) {
+        // Posição alvo = centro + deflexão/2048 * meia excursão, já em Q16.16
+        const int32_t scale = 1 << (MOTION_FRAC_BITS - MOTION_DEFLECTION_BITS);
+        int32_t target_x = motion->center_x + x_deflection * motion->half_x * scale;
+        int32_t target_y = motion->center_y - y_deflection * motion->half_y * scale;
+
+        motion->x += (target_x - motion->x) >> MOTION_SMOOTH_SHIFT;
+        motion->y += (target_y - motion->y) >> MOTION_SMOOTH_SHIFT;
+        motion_collide(&motion->x, &motion->vx, motion->min_x, motion->max_x);
+        motion_collide(&motion->y, &motion->vy, motion->min_y, motion->max_y);
+        return;
+    }
+
+    // Modo de taxa: a velocidade acelera em direção ao alvo da curva e a posição integra
+    motion->vx = motion_approach(motion->vx, motion_target_speed(x_deflection));
+    motion->vy = motion_approach(motion->vy, -motion_target_speed(y_deflection));
+    motion->x += motion->vx;
+    motion->y += motion->vy;
+    motion_collide(&motion->x, &motion->vx, motion->min_x, motion->max_x);
+    motion_collide(&motion->y, &motion->vy, motion->min_y, motion->max_y);
+}
@@ -0,0 +1,44 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include "pico/stdlib.h"
+
+// Defines
+#define MOTION_FRAC_BITS 16                       // posições e velocidades em Q16.16
+#define MOTION_ONE (1 << MOTION_FRAC_BITS)
+#define MOTION_DEFLECTION_BITS 11                 // deflexão calibrada de -2047 a 2047
+#define MOTION_CURVE_BITS 6                       // tabela de velocidade com 64 entradas
+#define MOTION_MAX_SPEED (3 * MOTION_ONE)         // pixels por passo com o joystick no extremo
+#define MOTION_ACCEL_SHIFT 2                      // a velocidade percorre 1/4 do caminho até o alvo por passo
+#define MOTION_SMOOTH_SHIFT 1                     // no modo absoluto, a posição percorre 1/2 do caminho por passo
+
+typedef enum {
+  MOTION_ABSOLUTE,   // a deflexão define a posição (centro com o joystick solto)
+  MOTION_RATE        // a deflexão define a velocidade; a posição é integrada a cada passo
+} motion_mode_t;
+
+// Modelo de movimento de um objeto na tela, integrado em passos de tempo fixos
+typedef struct {
+  motion_mode_t mode;
+  int32_t x, y;                    // posição (canto superior esquerdo) em Q16.16
+  int32_t vx, vy;                  // velocidade em Q16.16 pixels por passo
+  int32_t min_x, max_x, min_y, max_y;
+  int32_t center_x, center_y;
+  int32_t half_x, half_y;          // meia excursão em pixels (modo absoluto)
+} motion_t;
+
+// Cabeçalhos das funções
+void motion_init(motion_t *motion, int min_x, int min_y, int max_x, int max_y);
+void motion_set_mode(motion_t *motion, motion_mode_t mode);
+void motion_step(motion_t *motion, int16_t x_deflection, int16_t y_deflection);
+
+// Posição arredondada para o pixel mais próximo
+static inline int motion_pixel_x(const motion_t *motion) {
+    return (motion->x + (MOTION_ONE >> 1)) >> MOTION_FRAC_BITS;
+}
+
+static inline int motion_pixel_y(const motion_t *motion) {
+    return (motion->y + (MOTION_ONE >> 1)) >> MOTION_FRAC_BITS;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+// Declaração de variáveis
+// Cada etapa é escrita por um único núcleo; o relatório apenas lê e zera os dados
+static profile_stats_t stats[PROFILE_STAGES];
+static absolute_time_t next_report;
+static profile_callback_t record_callback;
+static const char *const stage_names[PROFILE_STAGES] = {
+    "acquire", "map", "pwm", "control", "draw", "flush", "bus", "frame"
+};
+
+// Funções
+
+// Função que registra a duração de uma etapa
+void profile_record(profile_stage_t stage, uint32_t duration_us) {
+    profile_stats_t *s = &stats[stage];
+    uint8_t bucket = duration_us ? 32 - __builtin_clz(duration_us) : 0;
+
+    if (s->count == 0 || duration_us < s->min)
+        s->min = duration_us;
+    if (duration_us > s->max)
+        s->max = duration_us;
+    s->sum += duration_us;
+    ++s->count;
+    ++s->histogram[bucket < PROFILE_BUCKETS ? bucket : PROFILE_BUCKETS - 1];
+    if (record_callback)
+        record_callback(stage, duration_us);
+}
+
+// Função que define quem recebe cada duração registrada (NULL desliga)
+void profile_set_callback(profile_callback_t callback) {
+    record_callback = callback;
+}
+
+// Função que registra o tempo desde a chamada anterior (período de um laço)
+void profile_tick(profile_stage_t stage) {
+    uint32_t now = time_us_32();
+    if (stats[stage].last_tick)
+        profile_record(stage, now - stats[stage].last_tick);
+    stats[stage].last_tick = now;
+}
+
+// Função que imprime, a cada PROFILE_REPORT_MS, uma linha por etapa com
+// contagem, mínimo/média/máximo (us) e o histograma, e reinicia as estatísticas
+void profile_report(void) {
+    if (!time_reached(next_report))
+        return;
+    next_report = make_timeout_time_ms(PROFILE_REPORT_MS);
+
+    for (uint8_t i = 0; i < PROFILE_STAGES; ++i) {
+        profile_stats_t *s = &stats[i];
+        if (s->count == 0)
+            continue;
+
+        printf("%-7s n=%lu min=%lu avg=%lu max=%lu |", stage_names[i], (unsigned long) s->count,
+               (unsigned long) s->min, (unsigned long) (s->sum / s->count), (unsigned long) s->max);
+        for (uint8_t b = 0; b < PROFILE_BUCKETS; ++b)
+            printf(" %lu", (unsigned long) s->histogram[b]);
+        printf("\n");
+
+        uint32_t last_tick = s->last_tick;
+        *s = (profile_stats_t){.last_tick = last_tick};
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+// Instrumentação de tempo por etapa. Com PROFILE_ENABLED em 0 (padrão) as macros não
+// geram código; para habilitar, configure o CMake com -DPROFILE_ENABLED=ON.
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+// Defines
+#define PROFILE_BUCKETS 16          // histograma em potências de 2 de microssegundos
+#define PROFILE_REPORT_MS 2000      // intervalo entre relatórios na saída USB
+
+typedef enum {
+  PROFILE_ACQUIRE,   // núcleo 1: filtragem do bloco do ADC
+  PROFILE_MAP,       // núcleo 1: calibração e mapeamento
+  PROFILE_PWM,       // núcleo 1: atualização dos LEDs
+  PROFILE_CONTROL,   // núcleo 1: período do ciclo de controle
+  PROFILE_DRAW,      // núcleo 0: composição do quadro
+  PROFILE_FLUSH,     // núcleo 0: envio ao display
+  PROFILE_BUS,       // núcleo 0: início do envio até o último byte no barramento
+  PROFILE_FRAME,     // núcleo 0: período do quadro
+  PROFILE_STAGES
+} profile_stage_t;
+
+typedef struct {
+  uint32_t count, min, max;
+  uint64_t sum;
+  uint32_t histogram[PROFILE_BUCKETS]; // faixa i: duração < 2^i us
+  uint32_t last_tick;                  // usado pelas etapas medidas como período
+} profile_stats_t;
+
+// Recebe cada duração registrada (por exemplo, para percentis na reprodução de gravações)
+typedef void (*profile_callback_t)(profile_stage_t stage, uint32_t duration_us);
+
+#if PROFILE_ENABLED
+#define PROFILE_BEGIN(stage) uint32_t profile_begin_##stage = time_us_32()
+#define PROFILE_END(stage) profile_record(stage, time_us_32() - profile_begin_##stage)
+#define PROFILE_TICK(stage) profile_tick(stage)
+#define PROFILE_REPORT() profile_report()
+#else
+#define PROFILE_BEGIN(stage) do { } while (0)
+#define PROFILE_END(stage) do { } while (0)
+#define PROFILE_TICK(stage) do { } while (0)
+#define PROFILE_REPORT() do { } while (0)
+#endif
+
+// Cabeçalhos das funções
+void profile_record(profile_stage_t stage, uint32_t duration_us);
+void profile_tick(profile_stage_t stage);
+void profile_report(void);
+void profile_set_callback(profile_callback_t callback);
+
+#endif
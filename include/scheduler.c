@@ -0,0 +1,83 @@
+#include "scheduler.h"
+
+// Funções
+
+// Função que inicializa um escalonador sem tarefas
+void scheduler_init(scheduler_t *scheduler) {
+    scheduler->count = 0;
+}
+
+// Função que registra uma tarefa periódica; a primeira execução é imediata
+// Retorna o índice da tarefa ou -1 se não houver espaço
+int scheduler_add(scheduler_t *scheduler, scheduler_callback_t callback, void *context, uint32_t period_us, uint8_t priority) {
+    if (scheduler->count >= SCHEDULER_MAX_TASKS)
+        return -1;
+
+    scheduler->tasks[scheduler->count] = (scheduler_task_t){
+        .callback = callback,
+        .context = context,
+        .period_us = period_us,
+        .priority = priority,
+        .deadline = get_absolute_time(),
+    };
+    return scheduler->count++;
+}
+
+// Função que altera o período de uma tarefa, valendo a partir do próximo prazo
+void scheduler_set_period(scheduler_t *scheduler, int task, uint32_t period_us) {
+    scheduler_task_t *t = &scheduler->tasks[task];
+    absolute_time_t limit = make_timeout_time_us(period_us);
+
+    t->period_us = period_us;
+    if (absolute_time_diff_us(limit, t->deadline) > 0)
+        t->deadline = limit; // encurta a espera se o novo período for menor
+}
+
+// Função que antecipa o próximo prazo de uma tarefa para agora (executa assim que o
+// escalonador rodar de novo); os prazos seguintes contam a partir daí
+void scheduler_trigger(scheduler_t *scheduler, int task) {
+    scheduler->tasks[task].deadline = get_absolute_time();
+}
+
+// Função que executa a tarefa vencida de maior prioridade (em empate, a de prazo mais
+// antigo) ou, se nenhuma venceu, dorme até o próximo prazo. Retorna true se executou
+bool scheduler_run_once(scheduler_t *scheduler) {
+    absolute_time_t now = get_absolute_time();
+    scheduler_task_t *ready = NULL;
+    absolute_time_t next = at_the_end_of_time;
+
+    for (uint8_t i = 0; i < scheduler->count; ++i) {
+        scheduler_task_t *t = &scheduler->tasks[i];
+
+        if (absolute_time_diff_us(now, t->deadline) > 0) {
+            if (absolute_time_diff_us(t->deadline, next) > 0)
+                next = t->deadline;
+            continue;
+        }
+        if (!ready || t->priority > ready->priority ||
+            (t->priority == ready->priority && absolute_time_diff_us(t->deadline, ready->deadline) > 0))
+            ready = t;
+    }
+
+    if (!ready) {
+        // Dorme em WFE até o alarme do próximo prazo (ou até outra interrupção)
+        best_effort_wfe_or_timeout(next);
+        return false;
+    }
+
+    // Taxa fixa: o próximo prazo conta a partir do anterior; se a tarefa atrasou mais
+    // de um período, recomeça a partir de agora em vez de executar em rajada
+    ready->deadline = delayed_by_us(ready->deadline, ready->period_us);
+    if (absolute_time_diff_us(ready->deadline, now) > 0)
+        ready->deadline = delayed_by_us(now, ready->period_us);
+
+    ready->callback(ready->context);
+    return true;
+}
+
+// Função que executa o escalonador indefinidamente
+void scheduler_run(scheduler_t *scheduler) {
+    while (true) {
+        scheduler_run_once(scheduler);
+    }
+}
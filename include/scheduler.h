@@ -0,0 +1,33 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "pico/stdlib.h"
+
+// Defines
+#define SCHEDULER_MAX_TASKS 8
+
+typedef void (*scheduler_callback_t)(void *context);
+
+typedef struct {
+  scheduler_callback_t callback;
+  void *context;
+  uint32_t period_us;
+  uint8_t priority;           // maior valor = mais urgente
+  absolute_time_t deadline;   // próximo instante de execução
+} scheduler_task_t;
+
+// Escalonador cooperativo por prazos (uma instância por núcleo)
+typedef struct {
+  scheduler_task_t tasks[SCHEDULER_MAX_TASKS];
+  uint8_t count;
+} scheduler_t;
+
+// Cabeçalhos das funções
+void scheduler_init(scheduler_t *scheduler);
+int scheduler_add(scheduler_t *scheduler, scheduler_callback_t callback, void *context, uint32_t period_us, uint8_t priority);
+void scheduler_set_period(scheduler_t *scheduler, int task, uint32_t period_us);
+void scheduler_trigger(scheduler_t *scheduler, int task);
+bool scheduler_run_once(scheduler_t *scheduler);
+void scheduler_run(scheduler_t *scheduler);
+
+#endif
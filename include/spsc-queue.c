@@ -0,0 +1,42 @@
+#include "spsc-queue.h"
+
+// Funções
+
+// Função que inicializa a fila sobre um buffer de capacity itens de item_size bytes
+void spsc_queue_init(spsc_queue_t *queue, void *buffer, size_t item_size, uint32_t capacity) {
+    queue->buffer = buffer;
+    queue->item_size = item_size;
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+// Função que insere um item (lado do produtor); retorna false se a fila estiver cheia
+bool spsc_queue_push(spsc_queue_t *queue, const void *item) {
+    uint32_t head = queue->head;
+    if (head - queue->tail == queue->capacity)
+        return false;
+
+    memcpy(&queue->buffer[(head & (queue->capacity - 1)) * queue->item_size], item, queue->item_size);
+    __dmb(); // o item precisa estar visível antes do novo head
+    queue->head = head + 1;
+    return true;
+}
+
+// Função que retira o item mais antigo (lado do consumidor); retorna false se a fila estiver vazia
+bool spsc_queue_pop(spsc_queue_t *queue, void *item) {
+    uint32_t tail = queue->tail;
+    if (queue->head == tail)
+        return false;
+
+    __dmb(); // lê o item só depois de observar o head
+    memcpy(item, &queue->buffer[(tail & (queue->capacity - 1)) * queue->item_size], queue->item_size);
+    __dmb(); // libera a posição só depois de copiar o item
+    queue->tail = tail + 1;
+    return true;
+}
+
+// Função que retorna quantos itens aguardam na fila
+uint32_t spsc_queue_level(const spsc_queue_t *queue) {
+    return queue->head - queue->tail;
+}
@@ -0,0 +1,25 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Fila sem travas para um único produtor e um único consumidor (por exemplo, um em
+// cada núcleo). O produtor só escreve head e o consumidor só escreve tail, então
+// nenhuma seção crítica é necessária; a capacidade deve ser potência de 2.
+typedef struct {
+  uint8_t *buffer;           // capacity * item_size bytes fornecidos pelo chamador
+  size_t item_size;
+  uint32_t capacity;
+  volatile uint32_t head;    // total de itens inseridos (escrito só pelo produtor)
+  volatile uint32_t tail;    // total de itens retirados (escrito só pelo consumidor)
+} spsc_queue_t;
+
+// Cabeçalhos das funções
+void spsc_queue_init(spsc_queue_t *queue, void *buffer, size_t item_size, uint32_t capacity);
+bool spsc_queue_push(spsc_queue_t *queue, const void *item);
+bool spsc_queue_pop(spsc_queue_t *queue, void *item);
+uint32_t spsc_queue_level(const spsc_queue_t *queue);
+
+#endif
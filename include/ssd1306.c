@@ -1,4 +1,22 @@
 #include "ssd1306.h"
+#include "font.h"
+#include "hardware/clocks.h"
+#include "ssd1306-i2c.pio.h"
+
+// Barramento I2C compartilhado: um envio DMA por vez; os demais displays do mesmo
+// barramento aguardam em fila, na ordem em que ficaram prontos
+typedef struct {
+  ssd1306_t *active;                     // display com envio em andamento
+  ssd1306_t *queue[SSD1306_BUS_QUEUE];   // displays com quadro pronto aguardando a vez
+  uint8_t head, count;
+} ssd1306_bus_t;
+
+// Declaração de variáveis
+static ssd1306_bus_t buses[SSD1306_NUM_BUSES];
+static bool pio_loaded[NUM_PIOS];   // programa I2C já carregado no bloco PIO
+static uint pio_offset[NUM_PIOS];   // endereço do programa na memória de instruções
+
+static void ssd1306_wait_bus(ssd1306_t *ssd);
 
 // Funções
 
@@ -18,12 +36,167 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8U;
+    ssd->external_vcc = external_vcc;
     ssd->address = address;
     ssd->i2c_port = i2c;
     ssd->bufsize = ssd->pages * ssd->width + 1;
+    ssd->transport = SSD1306_TRANSPORT_I2C;
+    ssd->pio = NULL;
+    ssd->sm = 0;
     ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
     ssd->ram_buffer[0] = 0x40;
     ssd->port_buffer[0] = 0x80;
+    ssd->shadow_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+    ssd->tx_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+    ssd->full_refresh = true; // o conteúdo inicial da memória do display é desconhecido
+    ssd->last_flush_bytes = 0;
+    ssd->dma_channel = -1;
+    ssd->dma_stream = NULL;
+    ssd->stream_len = 0;
+    ssd->queued = false;
+    ssd->start_line = 0;
+    ssd->start_line_pending = false;
+}
+
+/**
+ * @brief Inicializa o display SSD1306 em uma máquina de estado PIO.
+ *
+ * Igual a ssd1306_init, mas as transações usam o programa I2C do PIO em vez do
+ * controlador I2C. A máquina de estado deve ter sido preparada por ssd1306_pio_setup;
+ * displays na mesma máquina compartilham o barramento.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param width Largura do display em pixels.
+ * @param height Altura do display em pixels.
+ * @param external_vcc Indica se o display usa alimentação externa (true) ou interna (false).
+ * @param address Endereço I2C do display.
+ * @param pio Bloco PIO da máquina de estado.
+ * @param sm Máquina de estado devolvida por ssd1306_pio_setup.
+ */
+void ssd1306_init_pio(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, PIO pio, uint sm) {
+    ssd1306_init(ssd, width, height, external_vcc, address, NULL);
+    ssd->transport = SSD1306_TRANSPORT_PIO;
+    ssd->pio = pio;
+    ssd->sm = sm;
+}
+
+/**
+ * @brief Prepara uma máquina de estado PIO como mestre I2C nos pinos indicados.
+ *
+ * Carrega o programa I2C no bloco (uma vez por bloco), reserva uma máquina de
+ * estado livre e configura os pinos como dreno aberto: o PIO só controla a direção
+ * (com o OE invertido no GPIO) e os pull-ups mantêm as linhas em nível alto. Cada
+ * bit ocupa 32 ciclos do PIO, de modo que o divisor de clock fixa a taxa do barramento.
+ *
+ * @param pio Bloco PIO a usar.
+ * @param sda Pino SDA.
+ * @param scl Pino SCL (deve ser sda + 1).
+ * @param baudrate Frequência do barramento em Hz (1 MHz no fast mode plus).
+ * @return Máquina de estado reservada.
+ */
+int ssd1306_pio_setup(PIO pio, uint sda, uint scl, uint baudrate) {
+    uint index = pio_get_index(pio);
+
+    if (!pio_loaded[index]) {
+        pio_offset[index] = pio_add_program(pio, &ssd1306_i2c_program);
+        pio_loaded[index] = true;
+    }
+    uint offset = pio_offset[index];
+    int sm = pio_claim_unused_sm(pio, true);
+
+    pio_sm_config c = ssd1306_i2c_program_get_default_config(offset);
+    sm_config_set_out_pins(&c, sda, 1);   // out pindirs em SDA
+    sm_config_set_set_pins(&c, sda, 1);   // set pindirs das sequências de START e STOP
+    sm_config_set_in_pins(&c, sda);
+    sm_config_set_sideset_pins(&c, scl);
+    sm_config_set_jmp_pin(&c, sda);       // leitura do ACK
+    sm_config_set_out_shift(&c, false, true, 16);
+    sm_config_set_in_shift(&c, false, false, 8); // sem autopush: a FIFO RX nunca é lida
+    sm_config_set_clkdiv(&c, (float) clock_get_hz(clk_sys) / (32.0f * baudrate));
+
+    // Linhas em nível alto pelos pull-ups; os pinos saem em 0 quando habilitados
+    gpio_pull_up(scl);
+    gpio_pull_up(sda);
+    uint32_t both_pins = (1u << sda) | (1u << scl);
+    pio_sm_set_pins_with_mask(pio, sm, both_pins, both_pins);
+    pio_sm_set_pindirs_with_mask(pio, sm, both_pins, both_pins);
+    pio_gpio_init(pio, sda);
+    gpio_set_oeover(sda, GPIO_OVERRIDE_INVERT);
+    pio_gpio_init(pio, scl);
+    gpio_set_oeover(scl, GPIO_OVERRIDE_INVERT);
+    pio_sm_set_pins_with_mask(pio, sm, 0, both_pins);
+
+    pio_sm_init(pio, sm, offset + ssd1306_i2c_offset_entry_point, &c);
+    pio_sm_set_enabled(pio, sm, true);
+    return sm;
+}
+
+// Função que monta em words uma transação no formato da FIFO TX do programa I2C do
+// PIO (START, endereço, dados e STOP) e retorna o número de palavras
+static size_t ssd1306_pio_words(uint16_t *words, uint8_t address, const uint8_t *src, size_t len) {
+    size_t n = 0;
+
+    words[n++] = 1u << 10;   // START: 2 instruções
+    words[n++] = set_scl_sda_program_instructions[SSD1306_I2C_SC1_SD0];
+    words[n++] = set_scl_sda_program_instructions[SSD1306_I2C_SC0_SD0];
+    words[n++] = (address << 2) | 1u;   // endereço com bit de escrita; o bit 0 solta SDA no ACK
+    for (size_t i = 0; i < len; ++i)
+        words[n++] = (src[i] << 1) | ((i == len - 1) << 9) | 1u;
+    words[n++] = 2u << 10;   // STOP: 3 instruções
+    words[n++] = set_scl_sda_program_instructions[SSD1306_I2C_SC0_SD0];
+    words[n++] = set_scl_sda_program_instructions[SSD1306_I2C_SC1_SD0];
+    words[n++] = set_scl_sda_program_instructions[SSD1306_I2C_SC1_SD1];
+    return n;
+}
+
+// Função que verifica se a máquina PIO parou por NAK e, nesse caso, descarta o
+// restante da transação e a devolve ao ponto de entrada
+static bool ssd1306_pio_recover(ssd1306_t *ssd) {
+    if (!pio_interrupt_get(ssd->pio, ssd->sm))
+        return false;
+    if (ssd->dma_channel >= 0)
+        dma_channel_abort(ssd->dma_channel);
+    pio_sm_drain_tx_fifo(ssd->pio, ssd->sm);
+    pio_sm_exec(ssd->pio, ssd->sm, pio_encode_jmp(pio_offset[pio_get_index(ssd->pio)] + ssd1306_i2c_offset_entry_point));
+    pio_interrupt_clear(ssd->pio, ssd->sm);
+    ssd->full_refresh = true;
+    return true;
+}
+
+// Função que verifica se a máquina PIO consumiu a última palavra da FIFO e parou
+// esperando a próxima (o bit TXSTALL deve ter sido limpo antes do envio)
+static bool ssd1306_pio_idle(ssd1306_t *ssd) {
+    return pio_sm_is_tx_fifo_empty(ssd->pio, ssd->sm) &&
+           (ssd->pio->fdebug & (1u << (PIO_FDEBUG_TXSTALL_LSB + ssd->sm)));
+}
+
+/**
+ * @brief Envia uma transação bloqueante ao display pelo transporte configurado.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param src Bytes da transação (byte de controle seguido de comandos ou pixels).
+ * @param len Número de bytes.
+ */
+static void ssd1306_write(ssd1306_t *ssd, const uint8_t *src, size_t len) {
+    if (ssd->transport == SSD1306_TRANSPORT_I2C) {
+        i2c_write_blocking(ssd->i2c_port, ssd->address, src, len, false);
+        return;
+    }
+
+    uint16_t words[8];
+    size_t n = ssd1306_pio_words(words, ssd->address, NULL, 0) - 4; // START e endereço
+
+    for (size_t i = 0; i < n; ++i)
+        pio_sm_put_blocking(ssd->pio, ssd->sm, (uint32_t) words[i] << 16);
+    for (size_t i = 0; i < len; ++i)
+        pio_sm_put_blocking(ssd->pio, ssd->sm, (uint32_t) ((src[i] << 1) | ((i == len - 1) << 9) | 1u) << 16);
+    for (size_t i = n; i < n + 4; ++i)
+        pio_sm_put_blocking(ssd->pio, ssd->sm, (uint32_t) words[i] << 16);
+
+    // Limpo só agora, com palavras ainda na FIFO, como em ssd1306_bus_start
+    ssd->pio->fdebug = 1u << (PIO_FDEBUG_TXSTALL_LSB + ssd->sm);
+    while (!ssd1306_pio_idle(ssd) && !ssd1306_pio_recover(ssd))
+        tight_loop_contents();
 }
 
 /**
@@ -31,75 +204,598 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
  *
  * Envia uma sequência de comandos para configurar a memória de exibição, contraste, 
  * orientação e outras configurações essenciais para funcionamento adequado.
+ * A multiplexação e a ligação dos pinos COM seguem a altura do display (128x64 usa
+ * COM alternados, 128x32 sequenciais) e a pré-carga e a bomba de carga seguem a
+ * alimentação (interna ou externa). Todos os comandos vão em uma única transação,
+ * após um único byte de controle 0x00.
  *
  * @param ssd Ponteiro para a estrutura do display.
  */
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, SET_DISP | 0x00);
-    ssd1306_command(ssd, SET_MEM_ADDR);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-    ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-    ssd1306_command(ssd, SET_MUX_RATIO);
-    ssd1306_command(ssd, HEIGHT - 1);
-    ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-    ssd1306_command(ssd, SET_DISP_OFFSET);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, SET_COM_PIN_CFG);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, SET_DISP_CLK_DIV);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, SET_PRECHARGE);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, SET_VCOM_DESEL);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, SET_CONTRAST);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, SET_ENTIRE_ON);
-    ssd1306_command(ssd, SET_NORM_INV);
-    ssd1306_command(ssd, SET_CHARGE_PUMP);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, SET_DISP | 0x01);
-}
-
-/**
- * @brief Envia um comando ao display SSD1306 via I2C.
+    uint8_t commands[] = {
+        0x00, // byte de controle: sequência de comandos
+        SET_DISP | 0x00,
+        SET_SCROLL_OFF,
+        SET_MEM_ADDR, 0x01,
+        SET_DISP_START_LINE | 0x00,
+        SET_SEG_REMAP | 0x01,
+        SET_MUX_RATIO, ssd->height - 1,
+        SET_COM_OUT_DIR | 0x08,
+        SET_DISP_OFFSET, 0x00,
+        SET_COM_PIN_CFG, ssd->height > 32 ? 0x12 : 0x02,
+        SET_DISP_CLK_DIV, 0x80,
+        SET_PRECHARGE, ssd->external_vcc ? 0x22 : 0xF1,
+        SET_VCOM_DESEL, 0x30,
+        SET_CONTRAST, 0xFF,
+        SET_ENTIRE_ON,
+        SET_NORM_INV,
+        SET_CHARGE_PUMP, ssd->external_vcc ? 0x10 : 0x14,
+        SET_DISP | 0x01
+    };
+
+    ssd1306_wait_bus(ssd);
+    ssd1306_write(ssd, commands, sizeof(commands));
+    ssd->start_line = 0;
+    ssd->start_line_pending = false;
+}
+
+/**
+ * @brief Envia um comando ao display SSD1306.
  *
  * @param ssd Ponteiro para a estrutura do display.
  * @param command Comando a ser enviado.
  */
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_wait_bus(ssd); // não intercala com um envio assíncrono em andamento no barramento
     ssd->port_buffer[1] = command;
-    i2c_write_blocking(
-        ssd->i2c_port,
-        ssd->address,
-        ssd->port_buffer,
-        2,
-        false);
+    ssd1306_write(ssd, ssd->port_buffer, 2);
+}
+
+/**
+ * @brief Ajusta o contraste (corrente dos segmentos) do display.
+ *
+ * Com a imagem em repouso, um contraste baixo reduz o consumo do painel sem
+ * apagá-lo. Espera o fim de um envio assíncrono em andamento.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param contrast Contraste de 0 a 255 (0xFF após ssd1306_config).
+ */
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast) {
+    uint8_t commands[] = {0x00, SET_CONTRAST, contrast};
+
+    ssd1306_wait_bus(ssd);
+    ssd1306_write(ssd, commands, sizeof(commands));
+}
+
+/**
+ * @brief Liga ou desliga o painel (modo de repouso do SSD1306).
+ *
+ * Desligado, o painel fica apagado e consome poucos microampères, mas a RAM do
+ * display é mantida: ao religar, a última imagem volta sem reenvio.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param on true para ligar o painel.
+ */
+void ssd1306_set_power(ssd1306_t *ssd, bool on) {
+    ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
+}
+
+/**
+ * @brief Marca o quadro inteiro para ser reenviado na próxima atualização.
+ *
+ * Deve ser usada quando a memória do display deixa de refletir o shadow_buffer
+ * (por exemplo, após reconfigurar ou religar o painel).
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+void ssd1306_invalidate(ssd1306_t *ssd) {
+    ssd->full_refresh = true;
+}
+
+/**
+ * @brief Encontra as regiões do buffer que mudaram desde a última atualização.
+ *
+ * Compara o buffer RAM com o shadow_buffer coluna a coluna e agrupa as colunas
+ * alteradas em janelas (faixa de colunas x faixa de páginas). Colunas próximas
+ * (até SSD1306_MERGE_GAP colunas limpas entre elas) são unidas na mesma janela,
+ * pois o custo de abrir uma nova janela supera o de reenviar poucos bytes.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param windows Vetor de saída com até SSD1306_MAX_WINDOWS janelas.
+ * @return Número de janelas encontradas.
+ */
+static uint8_t ssd1306_find_windows(ssd1306_t *ssd, ssd1306_window_t *windows) {
+    uint8_t count = 0;
+    uint8_t mask = 0;      // páginas alteradas na janela aberta
+    int last_col = -1;     // última coluna alterada na janela aberta
+
+    if (ssd->full_refresh) {
+        windows[0] = (ssd1306_window_t){0, ssd->width - 1, 0, ssd->pages - 1};
+        return 1;
+    }
+
+    for (uint8_t col = 0; col < ssd->width; ++col) {
+        const uint8_t *ram = &ssd->ram_buffer[col * ssd->pages + 1];
+        const uint8_t *shadow = &ssd->shadow_buffer[col * ssd->pages + 1];
+
+        if (memcmp(ram, shadow, ssd->pages) == 0)
+            continue; // coluna inalterada
+
+        uint8_t col_mask = 0;
+        for (uint8_t page = 0; page < ssd->pages; ++page) {
+            if (ram[page] != shadow[page])
+                col_mask |= 1 << page;
+        }
+
+        // Abre uma nova janela se a coluna estiver longe da anterior; se o limite
+        // de janelas for atingido, estende a última
+        if (last_col < 0 || (col - last_col > SSD1306_MERGE_GAP + 1 && count < SSD1306_MAX_WINDOWS)) {
+            if (last_col >= 0) {
+                windows[count - 1].page_start = __builtin_ctz(mask);
+                windows[count - 1].page_end = 31 - __builtin_clz(mask);
+            }
+            windows[count++].col_start = col;
+            mask = 0;
+        }
+        windows[count - 1].col_end = col;
+        mask |= col_mask;
+        last_col = col;
+    }
+
+    if (count > 0) {
+        windows[count - 1].page_start = __builtin_ctz(mask);
+        windows[count - 1].page_end = 31 - __builtin_clz(mask);
+    }
+    return count;
+}
+
+/**
+ * @brief Copia uma janela do buffer RAM para o buffer de envio.
+ *
+ * Os bytes seguem a ordem do modo de endereçamento vertical (todas as páginas de
+ * uma coluna antes da próxima coluna), precedidos do byte de controle 0x40. O
+ * shadow_buffer é atualizado com o conteúdo enviado.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param w Janela a ser copiada.
+ * @return Tamanho da transação de dados, incluindo o byte de controle.
+ */
+static size_t ssd1306_gather_window(ssd1306_t *ssd, const ssd1306_window_t *w) {
+    uint8_t page_count = w->page_end - w->page_start + 1;
+    size_t len = 1;
+
+    ssd->tx_buffer[0] = 0x40;
+    for (uint8_t col = w->col_start; col <= w->col_end; ++col) {
+        size_t offset = col * ssd->pages + w->page_start + 1;
+        memcpy(&ssd->tx_buffer[len], &ssd->ram_buffer[offset], page_count);
+        memcpy(&ssd->shadow_buffer[offset], &ssd->ram_buffer[offset], page_count);
+        len += page_count;
+    }
+    return len;
 }
 
 /**
  * @brief Envia os dados do buffer RAM para o display SSD1306.
  *
- * Atualiza o display enviando os dados armazenados no buffer interno via I2C.
+ * Envia apenas as janelas que mudaram desde a última atualização, restringindo
+ * SET_COL_ADDR e SET_PAGE_ADDR a cada janela. Os comandos de endereçamento de uma
+ * janela vão em uma única transação I2C, seguida da transação com os pixels. Uma
+ * mudança de start_line vai por último, depois dos pixels.
  *
  * @param ssd Ponteiro para a estrutura do display.
  */
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, SET_COL_ADDR);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, SET_PAGE_ADDR);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-        ssd->i2c_port,
-        ssd->address,
-        ssd->ram_buffer,
-        ssd->bufsize,
+    ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+
+    ssd1306_wait_bus(ssd);
+    uint8_t count = ssd1306_find_windows(ssd, windows);
+
+    ssd->last_flush_bytes = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        const ssd1306_window_t *w = &windows[i];
+        uint8_t commands[7] = {
+            0x00, // byte de controle: sequência de comandos
+            SET_COL_ADDR, w->col_start, w->col_end,
+            SET_PAGE_ADDR, w->page_start, w->page_end
+        };
+        ssd1306_write(ssd, commands, sizeof(commands));
+
+        size_t len = ssd1306_gather_window(ssd, w);
+        ssd1306_write(ssd, ssd->tx_buffer, len);
+
+        // Contabiliza também o byte de endereço de cada transação
+        ssd->last_flush_bytes += sizeof(commands) + len + 2;
+    }
+    ssd->full_refresh = false;
+
+    if (ssd->start_line_pending) {
+        uint8_t commands[2] = {0x00, SET_DISP_START_LINE | ssd->start_line};
+        ssd1306_write(ssd, commands, sizeof(commands));
+        ssd->last_flush_bytes += sizeof(commands) + 1;
+        ssd->start_line_pending = false;
+    }
+}
+
+/**
+ * @brief Retorna o estado do barramento do display.
+ *
+ * Os dois primeiros barramentos são os controladores I2C; os seguintes, as
+ * máquinas de estado PIO.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+static ssd1306_bus_t *ssd1306_bus(ssd1306_t *ssd) {
+    if (ssd->transport == SSD1306_TRANSPORT_PIO)
+        return &buses[2 + pio_get_index(ssd->pio) * NUM_PIO_STATE_MACHINES + ssd->sm];
+    return &buses[i2c_get_index(ssd->i2c_port)];
+}
+
+/**
+ * @brief Verifica se o barramento está livre, liberando-o se o envio ativo terminou.
+ *
+ * O envio só termina quando o DMA esvaziou o buffer e o I2C (ou a máquina PIO)
+ * transmitiu o último byte da FIFO. Se a transmissão for abortada (por exemplo,
+ * por NACK), o estado de erro é limpo e o próximo envio do display reenviará o
+ * quadro completo.
+ *
+ * @param bus Barramento a verificar.
+ * @return true se nenhum envio está em andamento.
+ */
+static bool ssd1306_bus_idle(ssd1306_bus_t *bus) {
+    ssd1306_t *ssd = bus->active;
+
+    if (!ssd)
+        return true;
+    if (ssd->transport == SSD1306_TRANSPORT_PIO) {
+        if (!ssd1306_pio_recover(ssd) && (dma_channel_is_busy(ssd->dma_channel) || !ssd1306_pio_idle(ssd)))
+            return false;
+        bus->active = NULL;
+        return true;
+    }
+    if (dma_channel_is_busy(ssd->dma_channel))
+        return false;
+
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void) hw->clr_tx_abrt;
+        ssd->full_refresh = true;
+    }
+    if (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+        return false;
+
+    bus->active = NULL;
+    return true;
+}
+
+/**
+ * @brief Inicia a transferência DMA do quadro pronto de um display.
+ *
+ * @param bus Barramento livre do display.
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+static void ssd1306_bus_start(ssd1306_bus_t *bus, ssd1306_t *ssd) {
+    if (ssd->transport == SSD1306_TRANSPORT_PIO) {
+        // O endereço vai no próprio quadro; TXSTALL é limpo quando a FIFO já tem
+        // palavras, para que só a parada após a última palavra o marque de novo
+        bus->active = ssd;
+        dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->dma_stream, ssd->stream_len);
+        while (pio_sm_is_tx_fifo_empty(ssd->pio, ssd->sm) && dma_channel_is_busy(ssd->dma_channel))
+            tight_loop_contents();
+        ssd->pio->fdebug = 1u << (PIO_FDEBUG_TXSTALL_LSB + ssd->sm);
+        return;
+    }
+
+    // O endereço do escravo só pode ser alterado com o bloco I2C desabilitado
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    hw->enable = 0;
+    hw->tar = ssd->address;
+    hw->enable = 1;
+    bus->active = ssd;
+    dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->dma_stream, ssd->stream_len);
+}
+
+/**
+ * @brief Passa o barramento ao próximo display da fila, se ele estiver livre.
+ *
+ * @param bus Barramento a atender.
+ */
+static void ssd1306_bus_service(ssd1306_bus_t *bus) {
+    if (!ssd1306_bus_idle(bus) || bus->count == 0)
+        return;
+
+    ssd1306_t *next = bus->queue[bus->head];
+    bus->head = (bus->head + 1) % SSD1306_BUS_QUEUE;
+    --bus->count;
+    next->queued = false;
+    ssd1306_bus_start(bus, next);
+}
+
+/**
+ * @brief Aguarda até que o barramento do display não tenha envios em andamento nem na fila.
+ *
+ * Necessário antes de transações bloqueantes, que trocam o endereço do escravo.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+static void ssd1306_wait_bus(ssd1306_t *ssd) {
+    ssd1306_bus_t *bus = ssd1306_bus(ssd);
+
+    while (!ssd1306_bus_idle(bus) || bus->count > 0) {
+        ssd1306_bus_service(bus);
+        tight_loop_contents();
+    }
+}
+
+/**
+ * @brief Configura o envio assíncrono do display por DMA.
+ *
+ * Reserva um canal DMA que alimenta a FIFO de transmissão do I2C (ou da máquina
+ * PIO) e aloca o buffer do quadro em envio. Cada byte ocupa uma palavra de 16 bits
+ * no formato do registrador IC_DATA_CMD, o que permite marcar o STOP de cada
+ * transação e enviar todas as janelas de um quadro em uma única transferência DMA.
+ * No PIO, as palavras seguem o formato do programa I2C e o quadro inclui também
+ * as sequências de START e STOP e o endereço de cada transação.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+void ssd1306_dma_init(ssd1306_t *ssd) {
+    // Pior caso: todas as janelas com 7 bytes de comando e 1 de controle, mais o quadro
+    // inteiro e o comando de start_line; no PIO, mais START (3 palavras), endereço e
+    // STOP (4) em cada transação
+    size_t capacity = SSD1306_MAX_WINDOWS * 8 + ssd->bufsize + 2;
+    if (ssd->transport == SSD1306_TRANSPORT_PIO)
+        capacity += (SSD1306_MAX_WINDOWS * 2 + 1) * 8;
+    ssd->dma_stream = calloc(capacity, sizeof(uint16_t));
+    ssd->dma_channel = dma_claim_unused_channel(true);
+
+    dma_channel_config config = dma_channel_get_default_config(ssd->dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    if (ssd->transport == SSD1306_TRANSPORT_PIO) {
+        channel_config_set_dreq(&config, pio_get_dreq(ssd->pio, ssd->sm, true));
+        dma_channel_configure(ssd->dma_channel, &config, &ssd->pio->txf[ssd->sm], ssd->dma_stream, 0, false);
+        return;
+    }
+    channel_config_set_dreq(&config, i2c_get_dreq(ssd->i2c_port, true));
+    dma_channel_configure(
+        ssd->dma_channel,
+        &config,
+        &i2c_get_hw(ssd->i2c_port)->data_cmd,
+        ssd->dma_stream,
+        0,
         false);
 }
 
+// Função que acrescenta uma transação ao quadro em envio: no I2C, com STOP no último
+// byte; no PIO, com START, endereço e STOP
+static size_t ssd1306_stream_append(ssd1306_t *ssd, size_t n, const uint8_t *src, size_t len) {
+    uint16_t *stream = ssd->dma_stream;
+
+    if (ssd->transport == SSD1306_TRANSPORT_PIO)
+        return n + ssd1306_pio_words(&stream[n], ssd->address, src, len);
+
+    for (size_t i = 0; i < len; ++i)
+        stream[n + i] = src[i];
+    stream[n + len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    return n + len;
+}
+
+/**
+ * @brief Inicia o envio do buffer RAM para o display sem bloquear a CPU.
+ *
+ * As janelas alteradas são copiadas para o buffer do quadro em envio (front) e o
+ * DMA as entrega ao I2C em segundo plano. O buffer RAM (back) fica livre para ser
+ * redesenhado assim que a função retorna. Se o quadro anterior ainda estiver em
+ * envio, nada é feito: as alterações continuam pendentes e serão enviadas na
+ * próxima chamada, de modo que nenhum quadro é transmitido pela metade.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @return true se o quadro foi iniciado (ou não havia alterações), false se o anterior ainda está em envio.
+ */
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+    ssd1306_window_t windows[SSD1306_MAX_WINDOWS];
+
+    if (ssd->dma_channel < 0) { // DMA não configurado: recorre ao envio bloqueante
+        ssd1306_send_data(ssd);
+        return true;
+    }
+    if (!ssd1306_flush_done(ssd))
+        return false;
+
+    // Com o barramento ocupado por outro display, o quadro entra na fila; sem vaga,
+    // as alterações continuam pendentes para a próxima chamada
+    ssd1306_bus_t *bus = ssd1306_bus(ssd);
+    bool bus_free = bus->active == NULL && bus->count == 0;
+    if (!bus_free && bus->count == SSD1306_BUS_QUEUE)
+        return false;
+
+    uint8_t count = ssd1306_find_windows(ssd, windows);
+    size_t n = 0;
+
+    ssd->last_flush_bytes = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        const ssd1306_window_t *w = &windows[i];
+        uint8_t commands[7] = {
+            0x00,
+            SET_COL_ADDR, w->col_start, w->col_end,
+            SET_PAGE_ADDR, w->page_start, w->page_end
+        };
+        n = ssd1306_stream_append(ssd, n, commands, sizeof(commands));
+
+        size_t len = ssd1306_gather_window(ssd, w);
+        n = ssd1306_stream_append(ssd, n, ssd->tx_buffer, len);
+
+        ssd->last_flush_bytes += sizeof(commands) + len + 2;
+    }
+    ssd->full_refresh = false;
+
+    // A rolagem segue no mesmo quadro, depois dos pixels da linha nova
+    if (ssd->start_line_pending) {
+        uint8_t commands[2] = {0x00, SET_DISP_START_LINE | ssd->start_line};
+        n = ssd1306_stream_append(ssd, n, commands, sizeof(commands));
+        ssd->last_flush_bytes += sizeof(commands) + 1;
+        ssd->start_line_pending = false;
+    }
+
+    if (n == 0)
+        return true;
+
+    ssd->stream_len = n;
+    if (bus_free) {
+        ssd1306_bus_start(bus, ssd);
+    } else {
+        bus->queue[(bus->head + bus->count++) % SSD1306_BUS_QUEUE] = ssd;
+        ssd->queued = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Verifica se o último envio assíncrono do display terminou.
+ *
+ * Também libera o barramento e inicia o próximo display da fila, se houver.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @return true se não há envio em andamento nem quadro na fila.
+ */
+bool ssd1306_flush_done(ssd1306_t *ssd) {
+    if (ssd->dma_channel < 0)
+        return true;
+
+    ssd1306_bus_t *bus = ssd1306_bus(ssd);
+    ssd1306_bus_service(bus);
+    return bus->active != ssd && !ssd->queued;
+}
+
+/**
+ * @brief Aguarda o término do envio assíncrono em andamento.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ */
+void ssd1306_wait_flush(ssd1306_t *ssd) {
+    while (!ssd1306_flush_done(ssd))
+        tight_loop_contents();
+}
+
+/**
+ * @brief Avança as filas de envio de todos os barramentos, sem bloquear.
+ *
+ * Com vários displays no mesmo barramento, o próximo quadro da fila começa assim
+ * que o anterior termina, desde que alguma função do driver seja chamada; esta
+ * função permite fazer isso sem enviar um novo quadro. Displays em barramentos
+ * diferentes transmitem em paralelo. Todas as chamadas ao driver devem partir do
+ * mesmo núcleo.
+ */
+void ssd1306_service(void) {
+    for (uint8_t i = 0; i < SSD1306_NUM_BUSES; ++i)
+        ssd1306_bus_service(&buses[i]);
+}
+
+/**
+ * @brief Define a linha da RAM exibida no topo do display.
+ *
+ * O SET_DISP_START_LINE desloca a imagem verticalmente de forma circular: a linha
+ * line aparece no topo e as anteriores, abaixo da última. O comando segue no
+ * próximo envio, depois dos pixels, de modo que conteúdo e rolagem mudam juntos.
+ * As coordenadas de desenho continuam sendo linhas da RAM.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param line Linha da RAM (0 a height - 1).
+ */
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line) {
+    line %= ssd->height;
+    if (line != ssd->start_line) {
+        ssd->start_line = line;
+        ssd->start_line_pending = true;
+    }
+}
+
+/**
+ * @brief Inicia o modo gráfico rolante (osciloscópio) no display.
+ *
+ * Apaga o buffer e volta a rolagem ao início. A partir daí cada amostra ocupa uma
+ * linha da RAM, usada como buffer circular, e a rolagem por SET_DISP_START_LINE
+ * mantém a amostra mais recente na base do display e a mais antiga no topo.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param plot Estado do gráfico.
+ * @param traces Número de traços (até SSD1306_PLOT_TRACES).
+ */
+void ssd1306_plot_init(ssd1306_t *ssd, ssd1306_plot_t *plot, uint8_t traces) {
+    plot->head = 0;
+    plot->traces = traces < SSD1306_PLOT_TRACES ? traces : SSD1306_PLOT_TRACES;
+    for (uint8_t i = 0; i < SSD1306_PLOT_TRACES; ++i)
+        plot->last[i] = -1;
+    ssd1306_fill(ssd, false);
+    ssd1306_set_start_line(ssd, 0);
+}
+
+/**
+ * @brief Acrescenta uma amostra ao gráfico rolante.
+ *
+ * Apaga a linha mais antiga e desenha nela, para cada traço, o segmento horizontal
+ * entre a coluna da amostra anterior e a atual (o que mantém o traço contínuo).
+ * Em seguida avança a rolagem em uma linha. Como só a página dessa linha muda, o
+ * próximo envio transmite poucas colunas de um byte e o comando de rolagem, em vez
+ * do quadro inteiro.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param plot Estado do gráfico.
+ * @param columns Coluna de cada traço nesta amostra (0 a width - 1).
+ */
+void ssd1306_plot_push(ssd1306_t *ssd, ssd1306_plot_t *plot, const uint8_t *columns) {
+    uint8_t row = plot->head;
+
+    ssd1306_hline(ssd, 0, ssd->width - 1, row, false);
+    for (uint8_t i = 0; i < plot->traces; ++i) {
+        uint8_t x = columns[i] < ssd->width ? columns[i] : ssd->width - 1;
+        uint8_t from = plot->last[i] < 0 ? x : plot->last[i];
+        if (from < x)
+            ssd1306_hline(ssd, from, x, row, true);
+        else
+            ssd1306_hline(ssd, x, from, row, true);
+        plot->last[i] = x;
+    }
+
+    plot->head = (row + 1) % ssd->height;
+    ssd1306_set_start_line(ssd, plot->head); // a linha mais antiga vai para o topo
+}
+
+/**
+ * @brief Aloca uma camada estática com o tamanho do buffer de pixels do display.
+ *
+ * Camadas guardam fundos que não mudam entre quadros (bordas, molduras), para que
+ * cada quadro comece com uma única cópia em vez de redesenhar o fundo.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param layer Camada a ser inicializada.
+ */
+void ssd1306_layer_init(ssd1306_t *ssd, ssd1306_layer_t *layer) {
+    layer->size = ssd->bufsize - 1;
+    layer->data = calloc(layer->size, sizeof(uint8_t));
+}
+
+/**
+ * @brief Guarda o conteúdo atual do buffer RAM em uma camada.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param layer Camada de destino.
+ */
+void ssd1306_layer_save(ssd1306_t *ssd, ssd1306_layer_t *layer) {
+    memcpy(layer->data, &ssd->ram_buffer[1], layer->size);
+}
+
+/**
+ * @brief Substitui o buffer RAM pelo conteúdo de uma camada.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param layer Camada de origem.
+ */
+void ssd1306_layer_load(ssd1306_t *ssd, const ssd1306_layer_t *layer) {
+    memcpy(&ssd->ram_buffer[1], layer->data, layer->size);
+}
+
 /**
  * @brief Define o estado de um pixel no buffer do display.
  *
@@ -109,7 +805,10 @@ void ssd1306_send_data(ssd1306_t *ssd) {
  * @param value Estado do pixel (true para ligado, false para desligado).
  */
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-    uint16_t index = (y >> 3) + (x << 3) + 1;
+    if (x >= ssd->width || y >= ssd->height)
+        return;
+
+    uint16_t index = x * ssd->pages + (y >> 3) + 1;
     uint8_t pixel = (y & 0b111);
     if (value)
         ssd->ram_buffer[index] |= (1 << pixel);
@@ -120,15 +819,69 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
 /**
  * @brief Preenche todo o display com um único valor (ligado ou desligado).
  *
+ * Como cada byte do buffer guarda 8 pixels verticais, basta preencher os bytes
+ * de pixels de uma vez (o byte de controle na posição 0 é preservado).
+ *
  * @param ssd Ponteiro para a estrutura do display.
  * @param value Estado para preencher o display (true para ligado, false para desligado).
  */
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
+    memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+}
+
+/**
+ * @brief Desenha um retângulo preenchido no display.
+ *
+ * Aproveita a organização em páginas do SSD1306: em cada coluna, a faixa vertical
+ * do retângulo ocupa bytes consecutivos do buffer, com máscara apenas na primeira
+ * e na última página e bytes inteiros nas páginas do meio. As máscaras são
+ * calculadas uma única vez e repetidas em todas as colunas. O retângulo é
+ * recortado aos limites do display.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param top Coordenada Y do canto superior do retângulo.
+ * @param left Coordenada X do canto esquerdo do retângulo.
+ * @param width Largura do retângulo.
+ * @param height Altura do retângulo.
+ * @param value Estado do pixel (true para ligado, false para desligado).
+ */
+void ssd1306_fill_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
+    if (width == 0 || height == 0 || top >= ssd->height || left >= ssd->width)
+        return;
+
+    uint8_t right = (left + width > ssd->width) ? ssd->width - 1 : left + width - 1;
+    uint8_t bottom = (top + height > ssd->height) ? ssd->height - 1 : top + height - 1;
+
+    uint8_t first_page = top >> 3, last_page = bottom >> 3;
+    uint8_t first_mask = 0xFF << (top & 0b111);
+    uint8_t last_mask = 0xFF >> (7 - (bottom & 0b111));
+    uint8_t *column = &ssd->ram_buffer[left * ssd->pages + first_page + 1];
+    uint8_t *end = column + (right - left + 1) * ssd->pages;
+
+    // Faixa dentro de uma única página: um byte mascarado por coluna
+    if (first_page == last_page) {
+        uint8_t mask = first_mask & last_mask;
+        if (value) {
+            for (; column < end; column += ssd->pages)
+                *column |= mask;
+        } else {
+            for (; column < end; column += ssd->pages)
+                *column &= ~mask;
         }
+        return;
+    }
+
+    // Primeira e última página mascaradas, páginas do meio com bytes inteiros
+    uint8_t middle = last_page - first_page - 1;
+    for (; column < end; column += ssd->pages) {
+        if (value) {
+            column[0] |= first_mask;
+            column[middle + 1] |= last_mask;
+        } else {
+            column[0] &= ~first_mask;
+            column[middle + 1] &= ~last_mask;
+        }
+        memset(&column[1], value ? 0xFF : 0x00, middle);
     }
 }
 
@@ -141,20 +894,16 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
  * @param width Largura do retângulo.
  * @param height Altura do retângulo.
  * @param value Estado do pixel (true para ligado, false para desligado).
- * @param fill Se true, preenche o retângulo; se false, desenha apenas as bordas.
  */
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value) {
-    // Desenha a borda superior e inferior
-    for (uint8_t x = left; x < left + width; ++x) {
-        ssd1306_pixel(ssd, x, top, value);                    // Linha superior
-        ssd1306_pixel(ssd, x, top + height - 1, value);       // Linha inferior
-    }
+    if (width == 0 || height == 0)
+        return;
 
-    // Desenha a borda esquerda e direita
-    for (uint8_t y = top; y < top + height; ++y) {
-        ssd1306_pixel(ssd, left, y, value);                   // Linha esquerda
-        ssd1306_pixel(ssd, left + width - 1, y, value);       // Linha direita
-    }
+    // Bordas superior e inferior como faixas horizontais, esquerda e direita como faixas verticais
+    ssd1306_fill_rect(ssd, top, left, width, 1, value);
+    ssd1306_fill_rect(ssd, top + height - 1, left, width, 1, value);
+    ssd1306_fill_rect(ssd, top, left, 1, height, value);
+    ssd1306_fill_rect(ssd, top, left + width - 1, 1, height, value);
 }
 
 // Função que desenha uma borda de corações
@@ -174,38 +923,108 @@ void ssd1306_rect_hearts(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t widt
     }
 }
 
-// Função que desenha um coração 
+// Sprite do coração (5x5), uma coluna por byte:
+//   . # . # .
+//   # # # # #
+//   # # # # #
+//   . # # # .
+//   . . # . .
+static const uint8_t heart_data[] = {0x06, 0x0F, 0x1E, 0x0F, 0x06};
+static const ssd1306_sprite_t heart_sprite = {5, 5, heart_data};
+
+// Função que desenha um coração com a ponta superior central em (x, y)
 void ssd1306_draw_heart(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-    /*
-       Padrão do coração:
-       . # . # .
-       # # # # #
-       # # # # #
-       . # # # .
-       . . # . .
-    */
-    ssd1306_pixel(ssd, x - 1, y, value);
-    ssd1306_pixel(ssd, x + 1, y, value);
-    
-    ssd1306_pixel(ssd, x - 2, y + 1, value);
-    ssd1306_pixel(ssd, x - 1, y + 1, value);
-    ssd1306_pixel(ssd, x, y + 1, value);
-    ssd1306_pixel(ssd, x + 1, y + 1, value);
-    ssd1306_pixel(ssd, x + 2, y + 1, value);
-
-    ssd1306_pixel(ssd, x - 2, y + 2, value);
-    ssd1306_pixel(ssd, x - 1, y + 2, value);
-    ssd1306_pixel(ssd, x, y + 2, value);
-    ssd1306_pixel(ssd, x + 1, y + 2, value);
-    ssd1306_pixel(ssd, x + 2, y + 2, value);
-
-    ssd1306_pixel(ssd, x - 1, y + 3, value);
-    ssd1306_pixel(ssd, x, y + 3, value);
-    ssd1306_pixel(ssd, x + 1, y + 3, value);
-
-    ssd1306_pixel(ssd, x, y + 4, value);
+    ssd1306_blit(ssd, &heart_sprite, x - 2, y, value ? SSD1306_BLIT_OR : SSD1306_BLIT_CLEAR);
+}
+
+// Função que combina um byte do sprite com um byte do buffer conforme o modo
+static inline void ssd1306_blit_byte(uint8_t *dst, uint8_t bits, ssd1306_blit_mode_t mode) {
+    if (mode == SSD1306_BLIT_OR)
+        *dst |= bits;
+    else if (mode == SSD1306_BLIT_XOR)
+        *dst ^= bits;
+    else
+        *dst &= ~bits;
 }
 
+/**
+ * @brief Copia um sprite de 1 bit por pixel para o buffer do display.
+ *
+ * Cada byte do sprite é deslocado para o alinhamento vertical de y e combinado com
+ * no máximo duas páginas do buffer, de modo que um sprite de até 8 pixels de altura
+ * custa poucas operações por coluna. O sprite é recortado aos limites do display,
+ * inclusive para coordenadas negativas.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param sprite Sprite a ser desenhado.
+ * @param x Coordenada X da coluna esquerda do sprite.
+ * @param y Coordenada Y da linha superior do sprite.
+ * @param mode Modo de combinação (OR, XOR ou apagar).
+ */
+void ssd1306_blit(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, int16_t x, int16_t y, ssd1306_blit_mode_t mode) {
+    uint8_t sprite_pages = (sprite->height + 7) >> 3;
+    uint8_t shift = y & 0b111;
+    int16_t base_page = y >> 3; // deslocamento aritmético: arredonda para baixo com y negativo
+    int16_t col_start = x < 0 ? -x : 0;
+    int16_t col_end = (x + sprite->width > ssd->width) ? ssd->width - x : sprite->width;
+
+    for (int16_t col = col_start; col < col_end; ++col) {
+        const uint8_t *src = &sprite->data[col * sprite_pages];
+        uint8_t *dst = &ssd->ram_buffer[(x + col) * ssd->pages + 1];
+
+        for (int16_t page = 0; page < sprite_pages; ++page) {
+            uint16_t bits = (uint16_t) src[page] << shift;
+            int16_t target = base_page + page;
+
+            if (target >= 0 && target < ssd->pages)
+                ssd1306_blit_byte(&dst[target], bits & 0xFF, mode);
+            if (shift && target + 1 >= 0 && target + 1 < ssd->pages)
+                ssd1306_blit_byte(&dst[target + 1], bits >> 8, mode);
+        }
+    }
+}
+
+/**
+ * @brief Desenha um caractere da fonte 5x7 no display.
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param c Caractere a ser desenhado (minúsculas viram maiúsculas; fora da fonte vira espaço).
+ * @param x Coordenada X do canto esquerdo.
+ * @param y Coordenada Y do topo.
+ */
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    if (c >= 'a' && c <= 'z')
+        c -= 'a' - 'A';
+    if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR)
+        c = ' ';
+
+    ssd1306_sprite_t glyph = {FONT_WIDTH, FONT_HEIGHT, font5x7[c - FONT_FIRST_CHAR]};
+    ssd1306_blit(ssd, &glyph, x, y, SSD1306_BLIT_OR);
+}
+
+/**
+ * @brief Desenha uma string no display.
+ *
+ * Os caracteres avançam FONT_ADVANCE pixels; ao atingir a borda direita, o texto
+ * continua na linha seguinte (8 pixels abaixo).
+ *
+ * @param ssd Ponteiro para a estrutura do display.
+ * @param str String terminada em nulo.
+ * @param x Coordenada X inicial.
+ * @param y Coordenada Y inicial.
+ */
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+    for (; *str; ++str) {
+        if (x + FONT_WIDTH > ssd->width) {
+            x = 0;
+            y += FONT_HEIGHT;
+        }
+        if (y >= ssd->height)
+            break;
+        ssd1306_draw_char(ssd, *str, x, y);
+        x += FONT_ADVANCE;
+    }
+}
 
 /**
  * @brief Desenha uma linha entre dois pontos no display.
@@ -218,6 +1037,16 @@ void ssd1306_draw_heart(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
  * @param value Estado do pixel (true para ligado, false para desligado).
  */
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    // Linhas horizontais e verticais usam as faixas por página
+    if (y0 == y1) {
+        ssd1306_hline(ssd, x0 < x1 ? x0 : x1, x0 < x1 ? x1 : x0, y0, value);
+        return;
+    }
+    if (x0 == x1) {
+        ssd1306_vline(ssd, x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, value);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -256,8 +1085,8 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
  * @param value Estado do pixel (true para ligado, false para desligado).
  */
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-    for (uint8_t x = x0; x <= x1; ++x)
-        ssd1306_pixel(ssd, x, y, value);
+    if (x1 >= x0)
+        ssd1306_fill_rect(ssd, y, x0, x1 - x0 + 1, 1, value);
 }
 
 /**
@@ -270,31 +1099,6 @@ void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value
  * @param value Estado do pixel (true para ligado, false para desligado).
  */
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-    for (uint8_t y = y0; y <= y1; ++y)
-        ssd1306_pixel(ssd, x, y, value);
-}
-
-// Função que atualiza a posição do quadrado 8x8 de acordo com a posição de x e y do joystick
-void update_square_position(int *square_x, int *square_y, uint16_t vrx_value, uint16_t vry_value) {
-    // Calcula a nova posição com base nos valores do joystick
-    int delta_y = vrx_value / 32;
-    int delta_x = (4095 - vry_value) / 64;
-
-    // Atualiza as coordenadas do quadrado
-    *square_x = delta_x;
-    *square_y = delta_y;
-
-    // Limite do movimento do quadrado dentro da área da borda
-    if (*square_x < 8) {   // limite superior
-        *square_x = 8;
-    }
-    if (*square_x > 56) {  // limite inferior
-        *square_x = 56;
-    }
-    if (*square_y < 12) {  // limite da esquerda
-        *square_y = 12;
-    }
-    if (*square_y > 124) { // limite da direita
-        *square_y = 124;
-    }
+    if (y1 >= y0)
+        ssd1306_fill_rect(ssd, y0, x, 1, y1 - y0 + 1, value);
 }
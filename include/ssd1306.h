@@ -1,9 +1,15 @@
 #include <stdlib.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
 
-#define WIDTH 128
-#define HEIGHT 64
+#define SSD1306_NUM_BUSES (2 + NUM_PIOS * NUM_PIO_STATE_MACHINES) // controladores I2C e máquinas PIO
+#define SSD1306_BUS_QUEUE 4     // displays aguardando a vez em um mesmo barramento
+#define SSD1306_MAX_WINDOWS 8   // número máximo de janelas enviadas por atualização
+#define SSD1306_MERGE_GAP 2     // colunas limpas toleradas dentro de uma mesma janela
+#define SSD1306_PLOT_TRACES 4   // número máximo de traços no modo gráfico
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -22,28 +28,104 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_HSCROLL_RIGHT = 0x26,
+  SET_HSCROLL_LEFT = 0x27,
+  SET_VHSCROLL_RIGHT = 0x29,
+  SET_VHSCROLL_LEFT = 0x2A,
+  SET_SCROLL_OFF = 0x2E,
+  SET_SCROLL_ON = 0x2F,
+  SET_VSCROLL_AREA = 0xA3
 } ssd1306_command_t;
 
+typedef enum {
+  SSD1306_TRANSPORT_I2C,  // controlador I2C do RP2040 (até 400 kHz no fast mode)
+  SSD1306_TRANSPORT_PIO   // programa I2C em uma máquina de estado PIO (fast mode plus, 1 MHz)
+} ssd1306_transport_t;
+
 typedef struct {
   uint8_t width, height, pages, address;
-  i2c_inst_t *i2c_port;
+  ssd1306_transport_t transport;
+  i2c_inst_t *i2c_port;     // transporte I2C
+  PIO pio;                  // transporte PIO: bloco e máquina de estado configurados por ssd1306_pio_setup
+  uint sm;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t *shadow_buffer;   // cópia do conteúdo que já está na memória do display
+  uint8_t *tx_buffer;       // buffer de envio das janelas alteradas
+  bool full_refresh;        // força o envio do quadro completo na próxima atualização
+  size_t last_flush_bytes;  // bytes transmitidos no barramento na última atualização
+  int dma_channel;          // canal DMA do envio assíncrono (-1 se não configurado)
+  uint16_t *dma_stream;     // quadro em envio: palavras para IC_DATA_CMD ou para a FIFO TX do PIO
+  size_t stream_len;        // palavras do quadro em envio
+  bool queued;              // quadro pronto aguardando o barramento ficar livre
+  uint8_t start_line;       // linha da RAM exibida no topo do display
+  bool start_line_pending;  // start_line ainda não enviado ao display
 } ssd1306_t;
 
+typedef struct {
+  uint8_t col_start, col_end, page_start, page_end;
+} ssd1306_window_t;
+
+// Imagem de 1 bit por pixel no mesmo formato do buffer: coluna por coluna, com
+// (height + 7) / 8 bytes por coluna e o bit menos significativo no topo.
+// Bits além de height devem ser zero.
+typedef struct {
+  uint8_t width, height;
+  const uint8_t *data;
+} ssd1306_sprite_t;
+
+// Camada estática pré-renderizada (mesmo formato dos pixels do buffer RAM)
+typedef struct {
+  uint8_t *data;
+  size_t size;
+} ssd1306_layer_t;
+
+// Gráfico rolante: a RAM é um buffer circular de linhas, uma por amostra, e a
+// rolagem é feita pelo SET_DISP_START_LINE
+typedef struct {
+  uint8_t head;                        // linha da RAM que recebe a próxima amostra
+  uint8_t traces;
+  int16_t last[SSD1306_PLOT_TRACES];   // coluna da amostra anterior de cada traço (-1: nenhuma)
+} ssd1306_plot_t;
+
+typedef enum {
+  SSD1306_BLIT_OR,    // liga os pixels do sprite
+  SSD1306_BLIT_XOR,   // inverte os pixels do sprite
+  SSD1306_BLIT_CLEAR  // apaga os pixels do sprite
+} ssd1306_blit_mode_t;
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init_pio(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, PIO pio, uint sm);
+int ssd1306_pio_setup(PIO pio, uint sda, uint scl, uint baudrate);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
+void ssd1306_set_power(ssd1306_t *ssd, bool on);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+void ssd1306_dma_init(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_flush_done(ssd1306_t *ssd);
+void ssd1306_wait_flush(ssd1306_t *ssd);
+void ssd1306_service(void);
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line);
+void ssd1306_plot_init(ssd1306_t *ssd, ssd1306_plot_t *plot, uint8_t traces);
+void ssd1306_plot_push(ssd1306_t *ssd, ssd1306_plot_t *plot, const uint8_t *columns);
+void ssd1306_layer_init(ssd1306_t *ssd, ssd1306_layer_t *layer);
+void ssd1306_layer_save(ssd1306_t *ssd, ssd1306_layer_t *layer);
+void ssd1306_layer_load(ssd1306_t *ssd, const ssd1306_layer_t *layer);
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
+void ssd1306_fill_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value);
 void ssd1306_rect_hearts(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value);
 void ssd1306_draw_heart(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_blit(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, int16_t x, int16_t y, ssd1306_blit_mode_t mode);
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include <string.h>
+#include "trace.h"
+
+// Funções
+
+// Função que prepara a gravação em buffer; os instantes passados às funções de
+// registro são absolutos (us desde o boot) e ficam relativos a start_us
+void trace_init(trace_t *trace, uint8_t *buffer, size_t capacity, uint32_t start_us) {
+    trace->data = buffer;
+    trace->capacity = capacity;
+    trace->len = 0;
+    trace->pos = 0;
+    trace->start_us = start_us;
+    trace->last_us = 0;
+}
+
+// Função que reserva um registro de size bytes com o intervalo desde o anterior,
+// inserindo registros TRACE_GAP para intervalos longos; retorna NULL sem espaço.
+// Um instante anterior ao último registro (vindo de outra tarefa) conta como intervalo 0.
+static uint8_t *trace_append(trace_t *trace, uint32_t time_us, uint8_t type, size_t size) {
+    uint32_t now = time_us - trace->start_us;
+    uint32_t delta = (int32_t) (now - trace->last_us) > 0 ? now - trace->last_us : 0;
+
+    if (trace->len + size + 3 * (delta / TRACE_MAX_DELTA) > trace->capacity)
+        return NULL;
+    trace->last_us += delta;
+
+    while (delta > TRACE_MAX_DELTA) {
+        uint8_t *gap = &trace->data[trace->len];
+        gap[0] = TRACE_MAX_DELTA & 0xFF;
+        gap[1] = TRACE_MAX_DELTA >> 8;
+        gap[2] = TRACE_GAP;
+        trace->len += 3;
+        delta -= TRACE_MAX_DELTA;
+    }
+
+    uint8_t *record = &trace->data[trace->len];
+    record[0] = delta & 0xFF;
+    record[1] = delta >> 8;
+    record[2] = type;
+    trace->len += size;
+    return record;
+}
+
+// Função que grava uma leitura dos eixos; retorna false com o buffer cheio
+bool trace_record_sample(trace_t *trace, uint32_t time_us, uint16_t vrx_value, uint16_t vry_value) {
+    uint8_t *record = trace_append(trace, time_us, TRACE_SAMPLE, 6);
+
+    if (!record)
+        return false;
+    record[3] = vry_value & 0xFF;
+    record[4] = ((vrx_value & 0x0F) << 4) | ((vry_value >> 8) & 0x0F);
+    record[5] = (vrx_value >> 4) & 0xFF;
+    return true;
+}
+
+// Função que grava uma mudança de estado de um botão; retorna false com o buffer cheio
+bool trace_record_button(trace_t *trace, uint32_t time_us, uint8_t gpio, bool pressed) {
+    uint8_t *record = trace_append(trace, time_us, TRACE_BUTTON, 4);
+
+    if (!record)
+        return false;
+    record[3] = (gpio & 0x7F) | (pressed ? 0x80 : 0);
+    return true;
+}
+
+// Função que monta o cabeçalho de TRACE_HEADER_SIZE bytes da gravação
+void trace_header(const trace_t *trace, uint8_t *header) {
+    memcpy(header, TRACE_MAGIC, 4);
+    header[4] = TRACE_VERSION;
+    header[5] = header[6] = header[7] = 0;
+    for (uint8_t i = 0; i < 4; ++i)
+        header[8 + i] = (trace->len >> (8 * i)) & 0xFF;
+}
+
+// Função que abre uma gravação completa (cabeçalho e registros) para reprodução;
+// retorna false se o cabeçalho for inválido ou o arquivo estiver truncado
+bool trace_open(trace_t *trace, const uint8_t *file, size_t size) {
+    if (size < TRACE_HEADER_SIZE || memcmp(file, TRACE_MAGIC, 4) != 0 || file[4] != TRACE_VERSION)
+        return false;
+
+    uint32_t len = file[8] | (file[9] << 8) | (file[10] << 16) | ((uint32_t) file[11] << 24);
+    if (len > size - TRACE_HEADER_SIZE)
+        return false;
+
+    trace_init(trace, (uint8_t *) file + TRACE_HEADER_SIZE, len, 0);
+    trace->len = len;
+    return true;
+}
+
+// Função que lê o próximo evento da gravação; retorna false no fim
+bool trace_next(trace_t *trace, trace_event_t *event) {
+    while (trace->pos + 3 <= trace->len) {
+        const uint8_t *record = &trace->data[trace->pos];
+        uint8_t type = record[2];
+        if (type > TRACE_GAP)
+            return false; // gravação corrompida
+        size_t size = type == TRACE_SAMPLE ? 6 : type == TRACE_BUTTON ? 4 : 3;
+
+        if (trace->pos + size > trace->len)
+            return false;
+        trace->pos += size;
+        trace->last_us += record[0] | (record[1] << 8);
+        if (type == TRACE_GAP)
+            continue;
+
+        event->type = type;
+        event->time_us = trace->last_us;
+        if (type == TRACE_SAMPLE) {
+            event->vry_value = record[3] | ((record[4] & 0x0F) << 8);
+            event->vrx_value = (record[4] >> 4) | (record[5] << 4);
+        } else {
+            event->gpio = record[3] & 0x7F;
+            event->pressed = record[3] & 0x80;
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "pico/stdlib.h"
+
+// Defines
+// Gravação compacta das entradas (leituras do joystick e botões) para reprodução
+// determinística. Arquivo (little endian):
+//   0  magic      "JTRC"
+//   4  version    TRACE_VERSION
+//   5  reservado  3 bytes em zero
+//   8  length     uint32, bytes de registros após o cabeçalho
+//  12  registros  dt (uint16, us desde o registro anterior), tipo e dados:
+//                 TRACE_SAMPLE  Y/X de 12 bits em 3 bytes (como em usb-stream.h) -> 6 bytes
+//                 TRACE_BUTTON  gpio | pressionado << 7                          -> 4 bytes
+//                 TRACE_GAP     sem dados; só avança dt (intervalos acima de 65535 us)
+#define TRACE_MAGIC "JTRC"
+#define TRACE_VERSION 1
+#define TRACE_HEADER_SIZE 12
+#define TRACE_MAX_DELTA 0xFFFF
+
+typedef enum {
+  TRACE_SAMPLE,
+  TRACE_BUTTON,
+  TRACE_GAP
+} trace_record_type_t;
+
+typedef struct {
+  uint8_t *data;        // registros (sem o cabeçalho)
+  size_t capacity, len; // bytes disponíveis e usados
+  size_t pos;           // reprodução: próximo registro
+  uint32_t start_us;    // gravação: instante do início
+  uint32_t last_us;     // instante do último registro, relativo ao início
+} trace_t;
+
+typedef struct {
+  uint8_t type;         // trace_record_type_t (TRACE_SAMPLE ou TRACE_BUTTON)
+  uint32_t time_us;     // relativo ao início da gravação
+  uint16_t vrx_value, vry_value;
+  uint8_t gpio;
+  bool pressed;
+} trace_event_t;
+
+// Cabeçalhos das funções
+void trace_init(trace_t *trace, uint8_t *buffer, size_t capacity, uint32_t start_us);
+bool trace_record_sample(trace_t *trace, uint32_t time_us, uint16_t vrx_value, uint16_t vry_value);
+bool trace_record_button(trace_t *trace, uint32_t time_us, uint8_t gpio, bool pressed);
+void trace_header(const trace_t *trace, uint8_t *header);
+bool trace_open(trace_t *trace, const uint8_t *file, size_t size);
+bool trace_next(trace_t *trace, trace_event_t *event);
+
+#endif
@@ -0,0 +1,157 @@
+#include "usb-stream.h"
+#include "pico/stdio.h"
+#include "pico/stdio_usb.h"
+#include "spsc-queue.h"
+
+// Declaração de variáveis
+static stream_frame_t frame_buffer[STREAM_QUEUE_SIZE];
+static spsc_queue_t frame_queue;              // núcleo 1 (produtor) -> núcleo 0 (USB)
+static volatile stream_mode_t mode = STREAM_OFF;
+static uint16_t sequence;
+static uint8_t pending_flags;                 // STREAM_FLAG_OVERRUN a marcar no próximo quadro
+static uint32_t raw_cursor;                   // próximo bloco do anel a enviar
+static uint32_t last_poll_us;
+static uint16_t filtered[2 * STREAM_MAX_PAIRS];
+static size_t filtered_pairs;
+static uint32_t filtered_timestamp;
+
+// Funções
+
+// Função que calcula o Fletcher-16 de um trecho do quadro
+static uint16_t stream_checksum(const uint8_t *data, size_t len) {
+    uint16_t sum1 = 0, sum2 = 0;
+    for (size_t i = 0; i < len; ++i) {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+// Função que monta um quadro e o coloca na fila; sem espaço, o quadro é descartado
+// e o próximo leva a marca de perda
+static void stream_emit(stream_mode_t type, uint32_t timestamp, const uint16_t *samples, size_t pairs) {
+    stream_frame_t frame;
+
+    frame.length = stream_encode(frame.data, type | pending_flags, sequence++, timestamp, samples, pairs);
+    if (spsc_queue_push(&frame_queue, &frame))
+        pending_flags = 0;
+    else
+        pending_flags = STREAM_FLAG_OVERRUN;
+}
+
+// Função que inicializa a fila de quadros (antes de o núcleo 1 começar a produzir)
+void stream_init(void) {
+    spsc_queue_init(&frame_queue, frame_buffer, sizeof(stream_frame_t), STREAM_QUEUE_SIZE);
+}
+
+// Função que troca o modo de envio (chamada no núcleo 1, produtor dos quadros)
+void stream_set_mode(stream_mode_t new_mode) {
+    if (new_mode == mode)
+        return;
+
+    sequence = 0;
+    pending_flags = 0;
+    filtered_pairs = 0;
+    raw_cursor = joystick_stream_position() / JOYSTICK_BLOCK_SAMPLES; // começa no bloco em escrita
+    last_poll_us = time_us_32();
+    mode = new_mode;
+}
+
+// Função que retorna o modo de envio atual
+stream_mode_t stream_get_mode(void) {
+    return mode;
+}
+
+// Função que codifica pares intercalados [Y, X, ...] em um quadro; retorna o tamanho
+size_t stream_encode(uint8_t *out, uint8_t type, uint16_t sequence, uint32_t timestamp,
+                     const uint16_t *samples, size_t pairs) {
+    uint8_t *p = out;
+
+    *p++ = STREAM_SYNC0;
+    *p++ = STREAM_SYNC1;
+    *p++ = type;
+    *p++ = pairs;
+    *p++ = sequence;
+    *p++ = sequence >> 8;
+    *p++ = timestamp;
+    *p++ = timestamp >> 8;
+    *p++ = timestamp >> 16;
+    *p++ = timestamp >> 24;
+
+    for (size_t i = 0; i < pairs; ++i) {
+        uint16_t y = samples[2 * i] & 0x0FFF;
+        uint16_t x = samples[2 * i + 1] & 0x0FFF;
+        *p++ = y;
+        *p++ = (y >> 8) | (x << 4);
+        *p++ = x >> 4;
+    }
+
+    uint16_t checksum = stream_checksum(out + 2, p - out - 2);
+    *p++ = checksum;
+    *p++ = checksum >> 8;
+    return p - out;
+}
+
+// Função que envia, no modo bruto, todos os blocos completos do anel desde a última
+// chamada. Precisa ser chamada antes de o DMA dar a volta no anel (10 ms a 100 kS/s);
+// se atrasar mais que isso, pula para o bloco mais recente e marca a perda
+void stream_poll_raw(void) {
+    if (mode != STREAM_RAW)
+        return;
+
+    const uint32_t ring_blocks = JOYSTICK_RING_SAMPLES / JOYSTICK_BLOCK_SAMPLES;
+    uint32_t rate = joystick_stream_rate();
+    uint32_t now = time_us_32();
+    uint32_t write = joystick_stream_position();
+    uint32_t current = write / JOYSTICK_BLOCK_SAMPLES;
+    uint32_t block_us = (uint64_t) JOYSTICK_BLOCK_SAMPLES * 1000000 / rate;
+
+    // A posição do DMA é circular: um atraso maior que o anel (menos uma margem de dois
+    // blocos) não pode ser distinguido pela posição, então é detectado pelo tempo
+    if (now - last_poll_us > (ring_blocks - 2) * block_us) {
+        sequence += (now - last_poll_us) / block_us;
+        pending_flags = STREAM_FLAG_OVERRUN;
+        raw_cursor = (current - 1) & (ring_blocks - 1);
+    }
+    last_poll_us = now;
+
+    const uint16_t *ring = joystick_stream_ring();
+    while (raw_cursor != current) {
+        uint32_t start = raw_cursor * JOYSTICK_BLOCK_SAMPLES;
+        uint32_t age = (write - start) & (JOYSTICK_RING_SAMPLES - 1); // amostras desde o início do bloco
+        uint32_t timestamp = now - (uint32_t) ((uint64_t) age * 1000000 / rate);
+
+        stream_emit(STREAM_RAW, timestamp, &ring[start], STREAM_MAX_PAIRS);
+        raw_cursor = (raw_cursor + 1) & (ring_blocks - 1);
+    }
+}
+
+// Função que acumula uma leitura filtrada e envia o quadro quando ele completa
+void stream_push_filtered(uint16_t vrx_value, uint16_t vry_value) {
+    if (mode != STREAM_FILTERED)
+        return;
+
+    if (filtered_pairs == 0)
+        filtered_timestamp = time_us_32();
+    filtered[2 * filtered_pairs] = vry_value;
+    filtered[2 * filtered_pairs + 1] = vrx_value;
+    if (++filtered_pairs == STREAM_MAX_PAIRS) {
+        stream_emit(STREAM_FILTERED, filtered_timestamp, filtered, filtered_pairs);
+        filtered_pairs = 0;
+    }
+}
+
+// Função que escreve na USB os quadros prontos (chamada no núcleo 0); sem host
+// conectado, os quadros são descartados. Retorna o número de quadros consumidos
+size_t stream_flush(void) {
+    stream_frame_t frame;
+    size_t count = 0;
+    bool connected = stdio_usb_connected();
+
+    while (spsc_queue_pop(&frame_queue, &frame)) {
+        if (connected)
+            stdio_put_string((const char *) frame.data, frame.length, false, false); // sem tradução de \n
+        ++count;
+    }
+    return count;
+}
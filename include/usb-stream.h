@@ -0,0 +1,45 @@
+#ifndef USB_STREAM_H
+#define USB_STREAM_H
+
+#include "pico/stdlib.h"
+#include "joystick.h"
+
+// Defines
+// Quadro binário (little endian):
+//   0  sync       0xA5 0x5A
+//   2  type       modo (STREAM_RAW ou STREAM_FILTERED) | STREAM_FLAG_OVERRUN
+//   3  pairs      número de pares Y/X no quadro
+//   4  sequence   uint16, +1 por quadro (saltos indicam quadros perdidos)
+//   6  timestamp  uint32, instante (us) do primeiro par
+//  10  samples    pares de 12 bits em 3 bytes: Y[7:0], X[3:0]<<4 | Y[11:8], X[11:4]
+//   .  checksum   Fletcher-16 de type até o fim das amostras
+#define STREAM_SYNC0 0xA5
+#define STREAM_SYNC1 0x5A
+#define STREAM_HEADER_SIZE 10
+#define STREAM_MAX_PAIRS (JOYSTICK_BLOCK_SAMPLES / 2)   // um bloco do anel por quadro
+#define STREAM_FRAME_MAX (STREAM_HEADER_SIZE + 3 * STREAM_MAX_PAIRS + 2)
+#define STREAM_FLAG_OVERRUN 0x80   // amostras perdidas antes deste quadro
+#define STREAM_QUEUE_SIZE 64       // quadros em trânsito do núcleo 1 para o núcleo 0 (~40 ms a 100 kS/s)
+
+typedef enum {
+  STREAM_OFF,
+  STREAM_RAW,        // todas as amostras do anel da aquisição contínua
+  STREAM_FILTERED    // uma leitura filtrada por ciclo de controle
+} stream_mode_t;
+
+typedef struct {
+  uint8_t length;
+  uint8_t data[STREAM_FRAME_MAX];
+} stream_frame_t;
+
+// Cabeçalhos das funções
+void stream_init(void);
+void stream_set_mode(stream_mode_t mode);
+stream_mode_t stream_get_mode(void);
+size_t stream_encode(uint8_t *out, uint8_t type, uint16_t sequence, uint32_t timestamp,
+                     const uint16_t *samples, size_t pairs);
+void stream_poll_raw(void);
+void stream_push_filtered(uint16_t vrx_value, uint16_t vry_value);
+size_t stream_flush(void);
+
+#endif